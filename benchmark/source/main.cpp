@@ -0,0 +1,677 @@
+// throughput benchmark suite
+//
+// every dataset is generated in memory from a fixed seed, written once to an unlinked temporary file (so it
+// stays in the page cache), and read back by every case from the start of that file (the span backend reads
+// the generated data directly)
+
+#include <linr/buf_read.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// allocation counter
+// -----------------
+// only allocations through `operator new` are counted, `getline` grows its buffer with `realloc`
+
+namespace
+{
+    std::atomic<std::size_t> g_allocations = 0;
+
+    void* allocate(std::size_t size)
+    {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        if (auto* ptr = std::malloc(size == 0 ? 1 : size)) {
+            return ptr;
+        }
+        throw std::bad_alloc{};
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+// datasets
+// --------
+
+enum class Shape
+{
+    Int4,      // 4 ints, space separated
+    Float4,    // 4 floats, space separated
+    Mixed,     // int, double, word
+    Long,      // 64 ints
+    Ragged,    // 1 to 64 ints
+    Csv,       // 4 ints, comma separated
+    Tab,       // 4 ints, tab separated
+    Text,      // words, 10 to 200 bytes
+    Errors,    // 4 ints, half of the lines with an invalid token
+};
+
+struct Dataset
+{
+    std::string_view m_name;
+    std::string      m_data;
+    std::size_t      m_lines = 0;
+    std::FILE*       m_file  = nullptr;
+};
+
+class Generator
+{
+public:
+    explicit Generator(std::uint64_t seed)
+        : m_rng{ seed }
+    {
+    }
+
+    template <typename T>
+    void number(std::string& out, T min, T max)
+    {
+        auto value = T{};
+        if constexpr (std::integral<T>) {
+            value = std::uniform_int_distribution<T>{ min, max }(m_rng);
+        } else {
+            value = std::uniform_real_distribution<T>{ min, max }(m_rng);
+        }
+
+        auto buf      = std::array<char, 32>{};
+        auto [ptr, _] = std::to_chars(buf.data(), buf.data() + buf.size(), value);
+        out.append(buf.data(), ptr);
+    }
+
+    void word(std::string& out, std::size_t size)
+    {
+        for (auto i = 0u; i < size; ++i) {
+            out.push_back(static_cast<char>('a' + m_rng() % 26));
+        }
+    }
+
+    std::size_t below(std::size_t max) { return m_rng() % max; }
+
+private:
+    std::mt19937_64 m_rng;
+};
+
+std::string generate(Shape shape, std::size_t lines, std::uint64_t seed)
+{
+    constexpr auto int_min = std::numeric_limits<int>::min();
+    constexpr auto int_max = std::numeric_limits<int>::max();
+
+    auto gen  = Generator{ seed };
+    auto data = std::string{};
+
+    auto ints = [&](std::size_t count, char delim) {
+        for (auto i = 0u; i < count; ++i) {
+            if (i != 0) {
+                data.push_back(delim);
+            }
+            gen.number(data, int_min, int_max);
+        }
+    };
+
+    for (auto line = 0u; line < lines; ++line) {
+        switch (shape) {
+        case Shape::Int4: ints(4, ' '); break;
+        case Shape::Csv: ints(4, ','); break;
+        case Shape::Tab: ints(4, '\t'); break;
+        case Shape::Long: ints(64, ' '); break;
+        case Shape::Ragged: ints(1 + gen.below(64), ' '); break;
+        case Shape::Float4:
+            for (auto i = 0u; i < 4; ++i) {
+                if (i != 0) {
+                    data.push_back(' ');
+                }
+                gen.number(data, -1e6f, 1e6f);
+            }
+            break;
+        case Shape::Mixed:
+            gen.number(data, int_min, int_max);
+            data.push_back(' ');
+            gen.number(data, -1e9, 1e9);
+            data.push_back(' ');
+            gen.word(data, 4 + gen.below(12));
+            break;
+        case Shape::Text:
+            for (auto size = 10 + gen.below(191); size != 0;) {
+                auto word = std::min(size, 1 + gen.below(10));
+                gen.word(data, word);
+                if ((size -= word) != 0) {
+                    data.push_back(' ');
+                    --size;
+                }
+            }
+            break;
+        case Shape::Errors:
+            ints(4, ' ');
+            if (gen.below(2) == 0) {
+                data[data.rfind(' ') + 1] = 'x';    // the integer parser stops at the first non-digit
+            }
+            break;
+        }
+        data.push_back('\n');
+    }
+
+    return data;
+}
+
+// recorder
+// --------
+
+/**
+ * @brief Times the lines in blocks, so the clock is read once per block rather than once per line.
+ */
+class Recorder
+{
+public:
+    static constexpr std::size_t block_size = 32;
+
+    using Clock = std::chrono::steady_clock;
+
+    void start() noexcept { m_block_start = Clock::now(); }
+
+    void line(bool ok) { lines(1, ok ? 0 : 1); }
+
+    void lines(std::size_t count, std::size_t errors)
+    {
+        m_lines    += count;
+        m_errors   += errors;
+        m_in_block += count;
+        if (m_in_block >= block_size) {
+            auto now = Clock::now();
+            auto ns  = std::chrono::duration<double, std::nano>(now - m_block_start).count();
+            m_block_ns.push_back(ns / static_cast<double>(m_in_block));
+            m_block_start = now;
+            m_in_block    = 0;
+        }
+    }
+
+    std::size_t         m_lines    = 0;
+    std::size_t         m_errors   = 0;
+    std::size_t         m_in_block = 0;
+    std::vector<double> m_block_ns;
+    Clock::time_point   m_block_start;
+};
+
+// cases
+// -----
+
+using Body = std::function<void(const Dataset&, Recorder&)>;
+
+struct Case
+{
+    std::string m_name;
+    Shape       m_shape;
+    Body        m_body;
+};
+
+// the readers, each made from the stream of a dataset
+struct Backend
+{
+    std::string_view m_name;
+};
+
+template <typename Fn>
+void for_each_backend(Fn&& fn)
+{
+    constexpr auto size = std::size_t{ 1 } << 16;
+
+#if defined(LINR_ENABLE_GETLINE)
+    fn(Backend{ "getline" }, [](const Dataset& data) {
+        return linr::BasicBufReader<linr::detail::GetlineReader>{ data.m_file };
+    });
+    fn(Backend{ "buf-getline" }, [](const Dataset& data) {
+        return linr::BasicBufReader<linr::detail::BufGetlineReader>{ data.m_file, size };
+    });
+#endif
+    fn(Backend{ "fgets" }, [](const Dataset& data) {
+        return linr::BasicBufReader<linr::detail::FgetsReader>{ data.m_file };
+    });
+    fn(Backend{ "buf-fgets" }, [](const Dataset& data) {
+        return linr::BasicBufReader<linr::detail::BufFgetsReader>{ data.m_file, size };
+    });
+    fn(Backend{ "read-ahead" }, [](const Dataset& data) {
+        return linr::ReadAheadReader{ data.m_file, size, linr::ReadAhead{} };
+    });
+#if defined(LINR_POSIX)
+    fn(Backend{ "fd" }, [](const Dataset& data) { return linr::FdReader{ fileno(data.m_file), size }; });
+    fn(Backend{ "mapped" }, [](const Dataset& data) { return linr::MappedReader{ data.m_file }; });
+#endif
+    fn(Backend{ "span" }, [](const Dataset& data) { return linr::SpanReader{ data.m_data }; });
+}
+
+auto buf_reader(const Dataset& data)
+{
+    return linr::BufReader{ data.m_file, std::size_t{ 1 } << 16 };
+}
+
+bool stop(linr::Error error) noexcept
+{
+    return error == linr::Error::EndOfFile or error == linr::Error::Unknown;
+}
+
+template <typename... Ts>
+Body tuple_case(auto make, char delim = ' ')
+{
+    return [make, delim](const Dataset& data, Recorder& rec) {
+        auto reader = make(data);
+        while (true) {
+            auto result = reader.template read<Ts...>(std::nullopt, delim);
+            if (not result and stop(result.error())) {
+                break;
+            }
+            rec.line(result.has_value());
+        }
+    };
+}
+
+template <typename T, std::size_t N>
+Body array_case(auto make, char delim = ' ')
+{
+    return [make, delim](const Dataset& data, Recorder& rec) {
+        auto reader = make(data);
+        while (true) {
+            auto result = reader.template read<T, N>(std::nullopt, delim);
+            if (not result and stop(result.error())) {
+                break;
+            }
+            rec.line(result.has_value());
+        }
+    };
+}
+
+std::vector<Case> make_cases()
+{
+    auto cases = std::vector<Case>{};
+
+    // every backend on the same workload
+    for_each_backend([&](Backend backend, auto make) {
+        auto name = "int4/tuple/" + std::string{ backend.m_name };
+        cases.push_back({ std::move(name), Shape::Int4, tuple_case<int, int, int, int>(make) });
+    });
+
+    auto make = [](const Dataset& data) { return buf_reader(data); };
+
+    // tuple vs array vs string reads
+    cases.push_back({ "int4/array/buf", Shape::Int4, array_case<int, 4>(make) });
+    cases.push_back({ "float4/tuple/buf", Shape::Float4, tuple_case<float, float, float, float>(make) });
+    cases.push_back({ "mixed/tuple/buf", Shape::Mixed, tuple_case<int, double, std::string>(make) });
+    cases.push_back({ "mixed/tuple-view/buf", Shape::Mixed, tuple_case<int, double, linr::Str>(make) });
+    cases.push_back({ "text/getline/buf", Shape::Text, [](const Dataset& data, Recorder& rec) {
+        auto reader = buf_reader(data);
+        while (true) {
+            auto result = reader.read();
+            if (not result and stop(result.error())) {
+                break;
+            }
+            rec.line(result.has_value());
+        }
+    } });
+    cases.push_back({ "text/view/buf", Shape::Text, tuple_case<linr::Str>(make, '\n') });
+
+    // long and ragged lines
+    cases.push_back({ "long/array/buf", Shape::Long, array_case<int, 64>(make) });
+    cases.push_back({ "ragged/read-into/buf", Shape::Ragged, [](const Dataset& data, Recorder& rec) {
+        auto reader = buf_reader(data);
+        auto values = std::vector<int>{};
+        while (true) {
+            auto error = reader.read_into(values);
+            if (error and stop(*error)) {
+                break;
+            }
+            rec.line(not error.has_value());
+        }
+    } });
+
+    // delimiters
+    cases.push_back({ "csv/tuple/buf", Shape::Csv, tuple_case<int, int, int, int>(make, ',') });
+    cases.push_back({ "csv/read-csv/buf", Shape::Csv, [](const Dataset& data, Recorder& rec) {
+        auto reader = buf_reader(data);
+        while (true) {
+            auto result = reader.read_csv<int, int, int, int>();
+            if (not result and stop(result.error())) {
+                break;
+            }
+            rec.line(result.has_value());
+        }
+    } });
+    cases.push_back({ "tab/tuple/buf", Shape::Tab, tuple_case<int, int, int, int>(make, '\t') });
+
+    // errors
+    cases.push_back({ "errors/tuple/buf", Shape::Errors, tuple_case<int, int, int, int>(make) });
+
+    // bulk reads, timed per call of `Recorder::block_size` lines
+    cases.push_back({ "int4/batch/buf", Shape::Int4, [](const Dataset& data, Recorder& rec) {
+        auto reader = buf_reader(data);
+        auto rows   = std::vector<linr::Tup<int, int, int, int>>{};
+        while (true) {
+            rows.clear();
+            auto [count, error] = reader.read_batch(Recorder::block_size, rows);
+            rec.lines(count + (error and not stop(*error) ? 1 : 0), error and not stop(*error) ? 1 : 0);
+            if (error and stop(*error)) {
+                break;
+            }
+        }
+    } });
+    cases.push_back({ "int4/columns/buf", Shape::Int4, [](const Dataset& data, Recorder& rec) {
+        auto reader  = buf_reader(data);
+        auto columns = linr::Columns<int, int, int, int>{};
+        while (true) {
+            linr::util::for_each_tuple(columns, []<std::size_t I, typename C>(C& column) { column.clear(); });
+            auto [count, error] = reader.read_columns(Recorder::block_size, columns);
+            rec.lines(count + (error and not stop(*error) ? 1 : 0), error and not stop(*error) ? 1 : 0);
+            if (error and stop(*error)) {
+                break;
+            }
+        }
+    } });
+
+    return cases;
+}
+
+// runner
+// ------
+
+struct Options
+{
+    std::size_t      m_lines  = 200'000;
+    std::size_t      m_repeat = 5;
+    std::uint64_t    m_seed   = 42;
+    std::string_view m_filter;
+    bool             m_json = false;
+    bool             m_list = false;
+};
+
+struct Report
+{
+    std::string m_name;
+    std::size_t m_lines       = 0;
+    std::size_t m_errors      = 0;
+    std::size_t m_bytes       = 0;
+    double      m_seconds     = 0;    // median of the runs
+    double      m_p50         = 0;    // ns per line
+    double      m_p90         = 0;
+    double      m_p99         = 0;
+    double      m_max         = 0;
+    double      m_allocations = 0;    // per line
+};
+
+Report run(const Case& test, const Dataset& dataset, const Options& options)
+{
+    auto report   = Report{ .m_name = test.m_name, .m_bytes = dataset.m_data.size() };
+    auto seconds  = std::vector<double>{};
+    auto block_ns = std::vector<double>{};
+    auto allocs   = std::size_t{ 0 };
+
+    // the first run warms up the caches and isn't recorded
+    for (auto i = 0u; i <= options.m_repeat; ++i) {
+        std::rewind(dataset.m_file);
+
+        auto rec = Recorder{};
+        rec.m_block_ns.reserve(dataset.m_lines / Recorder::block_size + 1);
+
+        auto allocs_before = g_allocations.load(std::memory_order_relaxed);
+        auto start         = Recorder::Clock::now();
+        rec.start();
+
+        test.m_body(dataset, rec);
+
+        auto elapsed      = std::chrono::duration<double>(Recorder::Clock::now() - start).count();
+        auto allocs_after = g_allocations.load(std::memory_order_relaxed);
+
+        if (i == 0) {
+            continue;
+        }
+
+        seconds.push_back(elapsed);
+        block_ns.insert(block_ns.end(), rec.m_block_ns.begin(), rec.m_block_ns.end());
+        allocs += allocs_after - allocs_before;
+
+        report.m_lines  = rec.m_lines;
+        report.m_errors = rec.m_errors;
+    }
+
+    std::ranges::sort(seconds);
+    std::ranges::sort(block_ns);
+
+    auto percentile = [&](double p) {
+        if (block_ns.empty()) {
+            return 0.0;
+        }
+        auto index = static_cast<std::size_t>(p * static_cast<double>(block_ns.size() - 1));
+        return block_ns[index];
+    };
+
+    report.m_seconds     = seconds[seconds.size() / 2];
+    report.m_p50         = percentile(0.50);
+    report.m_p90         = percentile(0.90);
+    report.m_p99         = percentile(0.99);
+    report.m_max         = percentile(1.00);
+    report.m_allocations = static_cast<double>(allocs)
+                         / static_cast<double>(std::max(report.m_lines * options.m_repeat, std::size_t{ 1 }));
+
+    return report;
+}
+
+void print_header()
+{
+    std::printf(
+        "%-28s %10s %9s %8s %8s %8s %8s %8s %8s %9s\n",
+        "case",
+        "lines",
+        "errors",
+        "Mlines/s",
+        "MB/s",
+        "p50 ns",
+        "p90 ns",
+        "p99 ns",
+        "max ns",
+        "allocs/l"
+    );
+}
+
+void print_text(const Report& report)
+{
+    std::printf(
+        "%-28s %10zu %9zu %8.2f %8.1f %8.1f %8.1f %8.1f %8.1f %9.3f\n",
+        report.m_name.c_str(),
+        report.m_lines,
+        report.m_errors,
+        static_cast<double>(report.m_lines) / report.m_seconds / 1e6,
+        static_cast<double>(report.m_bytes) / report.m_seconds / 1e6,
+        report.m_p50,
+        report.m_p90,
+        report.m_p99,
+        report.m_max,
+        report.m_allocations
+    );
+}
+
+void print_json(const Report& report, bool first)
+{
+    std::printf(
+        "%s\n    {\"case\": \"%s\", \"lines\": %zu, \"errors\": %zu, \"bytes\": %zu, \"seconds\": %.9f, "
+        "\"lines_per_s\": %.1f, \"mb_per_s\": %.3f, \"ns_per_line\": {\"p50\": %.2f, \"p90\": %.2f, "
+        "\"p99\": %.2f, \"max\": %.2f}, \"allocations_per_line\": %.4f}",
+        first ? "" : ",",
+        report.m_name.c_str(),
+        report.m_lines,
+        report.m_errors,
+        report.m_bytes,
+        report.m_seconds,
+        static_cast<double>(report.m_lines) / report.m_seconds,
+        static_cast<double>(report.m_bytes) / report.m_seconds / 1e6,
+        report.m_p50,
+        report.m_p90,
+        report.m_p99,
+        report.m_max,
+        report.m_allocations
+    );
+}
+
+bool parse_number(std::string_view str, auto& out)
+{
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), out);
+    return ec == std::errc{} and ptr == str.data() + str.size();
+}
+
+int usage(const char* program, int code)
+{
+    std::fprintf(
+        code == 0 ? stdout : stderr,
+        "Usage: %s [OPTION]...\n\n"
+        "Options:\n"
+        "   --lines N       lines per dataset (default: 200000)\n"
+        "   --repeat N      recorded runs per case, after one warm-up run (default: 5)\n"
+        "   --seed N        seed of the dataset generator (default: 42)\n"
+        "   --filter TEXT   only run the cases whose name contains TEXT\n"
+        "   --json          print the results as JSON, to compare runs\n"
+        "   --list          list the cases and exit\n",
+        program
+    );
+    return code;
+}
+
+int main(int argc, char** argv)
+{
+    auto options = Options{};
+
+    for (auto i = 1; i < argc; ++i) {
+        auto arg   = std::string_view{ argv[i] };
+        auto value = [&] { return i + 1 < argc ? std::string_view{ argv[++i] } : std::string_view{}; };
+
+        if (arg == "--help" or arg == "-h") {
+            return usage(argv[0], 0);
+        } else if (arg == "--lines") {
+            if (not parse_number(value(), options.m_lines) or options.m_lines == 0) {
+                return usage(argv[0], 1);
+            }
+        } else if (arg == "--repeat") {
+            if (not parse_number(value(), options.m_repeat) or options.m_repeat == 0) {
+                return usage(argv[0], 1);
+            }
+        } else if (arg == "--seed") {
+            if (not parse_number(value(), options.m_seed)) {
+                return usage(argv[0], 1);
+            }
+        } else if (arg == "--filter") {
+            options.m_filter = value();
+        } else if (arg == "--json") {
+            options.m_json = true;
+        } else if (arg == "--list") {
+            options.m_list = true;
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return usage(argv[0], 1);
+        }
+    }
+
+    auto cases = make_cases();
+    std::erase_if(cases, [&](const Case& test) {
+        return test.m_name.find(options.m_filter) == std::string::npos;    //
+    });
+
+    if (options.m_list) {
+        for (const auto& test : cases) {
+            std::printf("%s\n", test.m_name.c_str());
+        }
+        return 0;
+    }
+
+    auto datasets = std::vector<Dataset>{};
+    auto dataset  = [&](Shape shape) -> Dataset& {
+        constexpr auto names = std::array{
+            "int4", "float4", "mixed", "long", "ragged", "csv", "tab", "text", "errors",
+        };
+
+        auto name  = std::string_view{ names[static_cast<std::size_t>(shape)] };
+        auto found = std::ranges::find(datasets, name, &Dataset::m_name);
+        if (found != datasets.end()) {
+            return *found;
+        }
+
+        auto& data   = datasets.emplace_back(name, generate(shape, options.m_lines, options.m_seed));
+        data.m_lines = options.m_lines;
+        data.m_file  = std::tmpfile();
+        if (data.m_file == nullptr
+            or std::fwrite(data.m_data.data(), 1, data.m_data.size(), data.m_file) != data.m_data.size()
+            or std::fflush(data.m_file) != 0) {
+            std::fprintf(stderr, "failed to write the %s dataset to a temporary file\n", name.data());
+            std::exit(1);
+        }
+        return data;
+    };
+
+    // generate up front, so growing `datasets` doesn't happen between runs
+    datasets.reserve(9);
+    for (const auto& test : cases) {
+        dataset(test.m_shape);
+    }
+
+    if (options.m_json) {
+        std::printf(
+            "{\n  \"lines\": %zu,\n  \"repeat\": %zu,\n  \"seed\": %llu,\n  \"results\": [",
+            options.m_lines,
+            options.m_repeat,
+            static_cast<unsigned long long>(options.m_seed)
+        );
+    } else {
+        print_header();
+    }
+
+    auto first = true;
+    for (const auto& test : cases) {
+        auto report = run(test, dataset(test.m_shape), options);
+        if (options.m_json) {
+            print_json(report, std::exchange(first, false));
+        } else {
+            print_text(report);
+        }
+        std::fflush(stdout);
+    }
+
+    if (options.m_json) {
+        std::printf("\n  ]\n}\n");
+    }
+
+    for (auto& data : datasets) {
+        std::fclose(data.m_file);
+    }
+}
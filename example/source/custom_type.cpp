@@ -2,6 +2,7 @@
 
 #include <linr/parser.hpp>    // linr::CustomParser and linr::CustomParseable
 #include <linr/read.hpp>
+#include <linr/scan.hpp>    // linr::scan_line
 
 struct Color
 {
@@ -16,26 +17,14 @@ struct linr::CustomParser<Color>
 {
     Result<Color> parse(Str str) const noexcept
     {
-        // parse string with the shape: `Color { <r> <g> <b> }`
-        //                               0     1 2   3   4   5
-        auto parts = linr::util::split<6>(str, ' ');
-        if (not parts) {
+        // parse string with the shape: `Color { <r> <g> <b> }`, braces are escaped as in std::format
+        auto values = linr::scan_line<"Color {{ {} {} {} }}", float, float, float>(str);
+        if (not values) {
             return make_error<Color>(Error::InvalidInput);
         }
 
-        if (parts->at(0) != "Color" || parts->at(1) != "{" || parts->at(5) != "}") {
-            return make_error<Color>(Error::InvalidInput);
-        }
-
-        auto r = linr::parse<float>(parts->at(2));
-        auto g = linr::parse<float>(parts->at(3));
-        auto b = linr::parse<float>(parts->at(4));
-
-        if (not r || not g || not b) {
-            return make_error<Color>(Error::InvalidInput);
-        }
-
-        return make_result<Color>(r.value(), g.value(), b.value());
+        auto [r, g, b] = values.value();
+        return make_result<Color>(r, g, b);
     }
 };
 
@@ -2,28 +2,70 @@
 #define LINR_BUF_READER_HPP
 
 #include "linr/common.hpp"
+#include "linr/detail/csv.hpp"
+#include "linr/detail/fixed_width.hpp"
+#include "linr/detail/line_range.hpp"
 #include "linr/detail/read.hpp"
+#include "linr/detail/read_ahead.hpp"
 #include "linr/parser.hpp"
+#include "linr/scan.hpp"
+#include "linr/stats.hpp"
+#include "linr/trace.hpp"
 
 #include <algorithm>
 
 namespace linr
 {
-    class BufReader
+    /**
+     * @brief Reader that retains its line buffer across reads.
+     *
+     * Since the buffer outlives a read, `Str` (`std::string_view`) can be read as well: the views refer to
+     * the line buffer and stay valid until the next read. The batch and column reads don't take `Str`, their
+     * lines share that buffer.
+     *
+     * @tparam R The line reader backend.
+     * @tparam S The type of the stream the backend reads from.
+     */
+    template <typename R, typename S = std::FILE*>
+        requires detail::LineReader<R, S>
+    class BasicBufReader
     {
     public:
-        BufReader(std::size_t size) noexcept
-            : m_stream{ stdin }
+        BasicBufReader(std::size_t size) noexcept
+            requires std::constructible_from<R, std::size_t>
+            : m_stream{ detail::default_stream<S>() }
             , m_reader{ size }
         {
         }
 
-        BufReader(std::FILE* stream, std::size_t size) noexcept
+        BasicBufReader(S stream, std::size_t size) noexcept
+            requires std::constructible_from<R, std::size_t>
             : m_stream{ stream }
             , m_reader{ size }
         {
         }
 
+        BasicBufReader(S stream, std::size_t size, ReadAhead read_ahead) noexcept
+            requires std::constructible_from<R, std::size_t, ReadAhead>
+            : m_stream{ stream }
+            , m_reader{ size, read_ahead }
+        {
+        }
+
+        BasicBufReader() noexcept
+            requires std::default_initializable<R>
+            : m_stream{ detail::default_stream<S>() }
+            , m_reader{}
+        {
+        }
+
+        BasicBufReader(S stream) noexcept
+            requires std::default_initializable<R>
+            : m_stream{ stream }
+            , m_reader{}
+        {
+        }
+
         /**
          * @brief Read multiple values from stream as tuple.
          *
@@ -34,7 +76,7 @@ namespace linr
             requires (sizeof...(Ts) > 1) and (std::movable<Ts> and ...)
         Results<Ts...> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
         {
-            return detail::read_impl<Ts...>(m_stream, m_reader, prompt, delim);
+            return detail::read_impl<Ts...>(m_stream, m_reader, prompt, delim, m_context);
         }
 
         /**
@@ -47,7 +89,7 @@ namespace linr
             requires std::movable<T>
         Result<T> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
         {
-            auto result = detail::read_impl<T>(m_stream, m_reader, prompt, delim);
+            auto result = detail::read_impl<T>(m_stream, m_reader, prompt, delim, m_context);
             if (result) {
                 return make_result<T>(std::get<0>(std::move(result).value()));
             }
@@ -61,7 +103,7 @@ namespace linr
          */
         Result<std::string> read(Opt<Str> prompt = std::nullopt) noexcept
         {
-            auto result = detail::read_impl<std::string>(m_stream, m_reader, prompt, '\n');
+            auto result = detail::read_impl<std::string>(m_stream, m_reader, prompt, '\n', m_context);
             if (result) {
                 return make_result<std::string>(std::get<0>(std::move(result).value()));
             }
@@ -77,17 +119,398 @@ namespace linr
         template <typename T, std::size_t N>
         AResults<T, N> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
         {
-            return detail::read_impl<T, N>(m_stream, m_reader, prompt, delim);
+            return detail::read_impl<T, N>(m_stream, m_reader, prompt, delim, m_context);
+        }
+
+        /**
+         * @brief Read a CSV record (RFC 4180) as tuple.
+         *
+         * Empty fields are kept, and the record must have exactly one field per type. A field may be quoted,
+         * a quoted field may contain the delimiter, newlines (the record then spans several lines), and
+         * escaped quotes (`""`). A trailing `\r` is dropped. Lines without quotes are split without the
+         * quote handling, and a quoted field is a view into the line unless it must be unescaped. A header
+         * can be skipped with a plain `read()`.
+         *
+         * @param delim Delimiter, only `char` so you can't use unicode.
+         */
+        template <Parseable... Ts>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+        Results<Ts...> read_csv(char delim = ',') noexcept
+        {
+            return detail::read_csv_impl<Ts...>(m_stream, m_reader, m_csv, delim, m_context);
+        }
+
+        /**
+         * @brief Read a fixed-width record as tuple, the fields are cut at the offsets of the layout.
+         *
+         * The line is sliced without being scanned for delimiters, see `linr::FixedLayout`.
+         *
+         * @param layout The columns of the record, one per type.
+         */
+        template <Parseable... Ts>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+        Results<Ts...> read_fixed(const FixedLayout<sizeof...(Ts)>& layout) noexcept
+        {
+            return detail::read_fixed_impl<Ts...>(m_stream, m_reader, layout, m_context);
+        }
+
+        /**
+         * @brief Read a fixed-width record as tuple, with a layout known at compile time.
+         *
+         * E.g. `read_fixed<linr::fixed_layout({ { 0, 4 }, { 4, 10 } }), int, std::string>()`.
+         */
+        template <FixedLayout Layout, Parseable... Ts>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+        Results<Ts...> read_fixed() noexcept
+        {
+            static_assert(Layout.columns.size() == sizeof...(Ts), "the layout must have one column per type");
+            return detail::read_fixed_impl<Ts...>(m_stream, m_reader, Layout, m_context);
+        }
+
+        /**
+         * @brief Read the fields of an aggregate from a line, one value per field in declaration order.
+         *
+         * @param prompt The prompt.
+         * @param delim Delimiter, only `char` so you can't use unicode.
+         */
+        template <ParseableAggregate T>
+        Result<T> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
+        {
+            return detail::read_impl<T>(m_stream, m_reader, prompt, delim, m_context);
+        }
+
+        /**
+         * @brief Read a line and parse it with a pattern, e.g. `scan<"x={} y={}", int, float>()`.
+         *
+         * See `linr::scan_line` for the pattern syntax.
+         *
+         * @param prompt The prompt.
+         */
+        template <FixedString Pattern, Parseable... Ts>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+        Results<Ts...> scan(Opt<Str> prompt = std::nullopt) noexcept
+        {
+            return detail::scan_impl<Pattern, Ts...>(m_stream, m_reader, prompt, m_context);
+        }
+
+        /**
+         * @brief Read all the values of a line into a vector, the number of values is only known at runtime.
+         *
+         * Leading, trailing, and repeated delimiters are ignored. `out` is cleared first, reuse it across
+         * calls to keep its capacity. On a parse error it holds the values parsed before the failing one, it
+         * stops the same way with `Error::Unknown` if `out` can't grow.
+         *
+         * @param out The vector the values are written to.
+         * @param delim Delimiter, only `char` so you can't use unicode.
+         * @return The error, if any.
+         */
+        template <Parseable T>
+            requires std::movable<T>
+        Opt<Error> read_into(std::vector<T>& out, char delim = ' ') noexcept
+        {
+            return detail::read_into_impl(m_stream, m_reader, std::nullopt, out, delim, m_context);
+        }
+
+        /**
+         * @brief Read all the values of a line as a vector.
+         *
+         * @param prompt The prompt.
+         * @param delim Delimiter, only `char` so you can't use unicode.
+         */
+        template <detail::ParseableVector V>
+        Result<V> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
+        {
+            auto values = V{};
+            if (auto error = detail::read_into_impl(m_stream, m_reader, prompt, values, delim, m_context)) {
+                return make_error<V>(*error);
+            }
+            return make_result<V>(std::move(values));
+        }
+
+        /**
+         * @brief Read up to `max_lines` lines as tuples, appending them to `out`.
+         *
+         * Stops at the first error, the line that caused it is consumed but not appended (`Error::Unknown` if
+         * `out` can't grow). Reuse `out` (clear it between batches) to keep its capacity.
+         *
+         * @param max_lines Maximum number of lines to read.
+         * @param out Vector the parsed lines are appended to.
+         * @param delim Delimiter, only `char` so you can't use unicode.
+         * @return The number of lines appended and the error that stopped the batch early, if any.
+         */
+        template <Parseable... Ts>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+        BatchResult read_batch(std::size_t max_lines, std::vector<Tup<Ts...>>& out, char delim = ' ') noexcept
+        {
+            static_assert(
+                (not detail::Borrowed<Ts> and ...),
+                "read_batch reuses the line buffer for every line, read std::string instead of string views"
+            );
+
+            return detail::read_batch_impl<Ts...>(m_stream, m_reader, max_lines, out, delim, m_context);
+        }
+
+        /**
+         * @brief Read up to `max_lines` lines as arrays, appending them to `out`.
+         *
+         * Same semantics as the tuple overload.
+         *
+         * @param max_lines Maximum number of lines to read.
+         * @param out Vector the parsed lines are appended to.
+         * @param delim Delimiter, only `char` so you can't use unicode.
+         * @return The number of lines appended and the error that stopped the batch early, if any.
+         */
+        template <Parseable T, std::size_t N>
+            requires (std::movable<T> and N > 0)
+        BatchResult read_batch(std::size_t max_lines, std::vector<Arr<T, N>>& out, char delim = ' ') noexcept
+        {
+            static_assert(
+                not detail::Borrowed<T>,
+                "read_batch reuses the line buffer for every line, read std::string instead of string views"
+            );
+
+            return detail::read_batch_impl<T, N>(m_stream, m_reader, max_lines, out, delim, m_context);
         }
 
-        void set_stream(std::FILE* stream) { m_stream = stream; }
+        /**
+         * @brief Read up to `max_rows` lines, appending each value to the column of its type.
+         *
+         * The values are parsed straight into the columns, no intermediate tuple is built. Stops at the first
+         * error, the fields already appended for the failing line are removed so the columns keep the same
+         * length. Reuse `columns` across calls (and `util::reserve_columns` it) to avoid allocation.
+         *
+         * @param max_rows Maximum number of lines to read.
+         * @param columns The columns the parsed values are appended to.
+         * @param delim Delimiter, only `char` so you can't use unicode.
+         * @return The number of rows appended and the error that stopped the read early, if any.
+         */
+        template <Parseable... Ts>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+        BatchResult read_columns(std::size_t max_rows, Columns<Ts...>& columns, char delim = ' ') noexcept
+        {
+            static_assert(
+                (not detail::Borrowed<Ts> and ...),
+                "read_columns reuses the line buffer for every line, read std::string instead of string views"
+            );
 
-        std::FILE* get_stream() const { return m_stream; }
+            return detail::read_columns_impl<Ts...>(m_stream, m_reader, max_rows, columns, delim, m_context);
+        }
+
+        /**
+         * @brief Read up to `max_rows` lines into newly created columns.
+         *
+         * A parse error in any line fails the whole read, use the other overload to keep the rows before it.
+         *
+         * @param max_rows Maximum number of lines to read.
+         * @param delim Delimiter, only `char` so you can't use unicode.
+         * @param reserve Number of rows to reserve in each column up front, e.g. `linr::Reserve{ 1024 }`.
+         * @return The columns, or the error that stopped the read unless it's the end of the stream after
+         * at least one row.
+         */
+        template <Parseable... Ts>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+        Result<Columns<Ts...>> read_columns(
+            std::size_t max_rows,
+            char        delim   = ' ',
+            Reserve     reserve = {}
+        ) noexcept
+        {
+            static_assert(
+                (not detail::Borrowed<Ts> and ...),
+                "read_columns reuses the line buffer for every line, read std::string instead of string views"
+            );
+
+            auto columns = Columns<Ts...>{};
+            try {
+                util::reserve_columns(columns, reserve.rows);
+            } catch (...) {
+                return make_error<Columns<Ts...>>(Error::Unknown);
+            }
+
+            // only reaching the end of the stream after some rows is a success
+            auto [count, error] = read_columns(max_rows, columns, delim);
+            if (error.has_value() and (count == 0 or *error != Error::EndOfFile)) {
+                return make_error<Columns<Ts...>>(*error);
+            }
+            return make_result<Columns<Ts...>>(std::move(columns));
+        }
+
+        /**
+         * @brief Lazily read the remaining lines as an input range of `Results<Ts...>`.
+         *
+         * Parse errors are yielded as they come, the range ends at EOF (or right after yielding any other
+         * stream error). Composes with `std::views`, e.g. `reader.lines<int, float>() | std::views::take(n)`
+         * reads only `n` lines. The reader must outlive the range.
+         *
+         * @param delim Delimiter, only `char` so you can't use unicode.
+         */
+        template <Parseable... Ts>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+        detail::LineRange<S, R, Ts...> lines(char delim = ' ') noexcept
+        {
+            return { m_stream, m_reader, delim, m_context };
+        }
+
+        /**
+         * @brief Read from another stream, the line reader drops whatever it kept from the previous one.
+         */
+        void set_stream(S stream)
+        {
+            m_stream = stream;
+            if constexpr (requires { m_reader.reset(); }) {
+                m_reader.reset();
+            }
+        }
+
+        S get_stream() const { return m_stream; }
+
+        /**
+         * @brief Set the context handed to the parsers, e.g. to allocate `std::pmr::string` from an arena.
+         *
+         * The parsed values allocated from the resource must be destroyed before the resource is released.
+         */
+        void set_context(ParseContext context) { m_context = context; }
+
+        ParseContext get_context() const { return m_context; }
+
+        /**
+         * @brief Get a snapshot of the statistics, only for readers that keep them (see `StatsBufReader`).
+         */
+        ReaderStats stats() const noexcept
+            requires requires (const R& r) { { r.stats() } noexcept -> std::same_as<ReaderStats>; }
+        {
+            return m_reader.stats();
+        }
+
+        /**
+         * @brief Reset the counters and times of the statistics, e.g. after exporting a snapshot.
+         */
+        void reset_stats() noexcept
+            requires requires (R& r) { r.reset_stats(); }
+        {
+            m_reader.reset_stats();
+        }
+
+        /**
+         * @brief Set the tracer the phases of the reads are reported to, only for traced readers (see
+         * `TracedBufReader`). Null stops the tracing. The tracer must outlive the reads.
+         */
+        template <Tracer T>
+        void set_tracer(T* tracer) noexcept
+            requires requires (R& r) { r.set_tracer(tracer); }
+        {
+            m_reader.set_tracer(tracer);
+        }
+
+        auto get_tracer() const noexcept
+            requires requires (const R& r) { r.get_tracer(); }
+        {
+            return m_reader.get_tracer();
+        }
 
     private:
-        std::FILE*        m_stream;
-        detail::BufReader m_reader;
+        S                  m_stream;
+        R                  m_reader;
+        ParseContext       m_context = {};
+        detail::CsvBuffers m_csv;
     };
+
+    using BufReader = BasicBufReader<detail::BufReader>;
+
+    /**
+     * @brief Buffered reader that reads the stream on a background thread while the caller parses.
+     *
+     * Construct it with `ReadAheadReader{ stream, size, ReadAhead{ .buffers = 4 } }`, `size` being the size
+     * of each buffer of the ring. On POSIX each buffer is handed over with whatever a single `read(2)`
+     * returned, so lines from a pipe or a terminal aren't held back; elsewhere a buffer is handed over once
+     * it's full (or the stream ends). `set_stream` stops the background thread, the next read starts another.
+     */
+    using ReadAheadReader = BasicBufReader<detail::ReadAheadReader>;
+
+    /**
+     * @brief Reader over a buffer that is already in memory, e.g. `SpanReader{ std::string_view{ data } }`.
+     *
+     * The lines are views into the buffer, so nothing is copied and no system call is made. The buffer must
+     * outlive the reader and the views read from it. A string literal converts to a span that includes its
+     * null terminator, wrap it in a `std::string_view` instead. `set_stream` starts over from the beginning
+     * of the buffer it's given, which may be the same buffer refilled.
+     */
+    using SpanReader = BasicBufReader<detail::SpanReader, std::span<const char>>;
+
+#if defined(LINR_POSIX)
+    /**
+     * @brief Buffered reader that reads from a file descriptor directly, bypassing stdio.
+     */
+    using FdReader = BasicBufReader<detail::FdReader, int>;
+
+    /**
+     * @brief Reader that maps a regular file into memory, the parsed strings are taken from the mapping.
+     */
+    using MappedReader = BasicBufReader<detail::MappedReader>;
+#endif
+
+    /**
+     * @brief `BufReader` that keeps statistics about its reads, see `linr::ReaderStats`.
+     *
+     * Get them with `stats()` and start over with `reset_stats()`. The readers without stats don't pay for
+     * them: the stats live in a wrapper around the line reader, and the read functions notify a probe that
+     * does nothing unless the reader has one.
+     *
+     * @tparam L Whether the time spent in each phase is measured as well.
+     */
+    template <StatsLevel L = StatsLevel::Counters>
+    using StatsBufReader = BasicBufReader<detail::StatsReader<detail::BufReader, L>>;
+
+    /**
+     * @brief `ReadAheadReader` that keeps statistics about its reads, see `linr::StatsBufReader`.
+     */
+    template <StatsLevel L = StatsLevel::Counters>
+    using StatsReadAheadReader = BasicBufReader<detail::StatsReader<detail::ReadAheadReader, L>>;
+
+#if defined(LINR_POSIX)
+    /**
+     * @brief `FdReader` that keeps statistics about its reads, see `linr::StatsBufReader`.
+     */
+    template <StatsLevel L = StatsLevel::Counters>
+    using StatsFdReader = BasicBufReader<detail::StatsReader<detail::FdReader, L>, int>;
+
+    /**
+     * @brief `MappedReader` that keeps statistics about its reads, see `linr::StatsBufReader`.
+     */
+    template <StatsLevel L = StatsLevel::Counters>
+    using StatsMappedReader = BasicBufReader<detail::StatsReader<detail::MappedReader, L>>;
+#endif
+
+    /**
+     * @brief `BufReader` that reports the read, split, and parse phases of its reads to a tracer.
+     *
+     * The tracer is chosen at compile time and set with `set_tracer()`, e.g. a `linr::ChromeTrace`. Like
+     * the stats, the readers without a tracer don't pay for the tracing.
+     *
+     * @tparam T The tracer type, see `linr::Tracer`.
+     */
+    template <Tracer T>
+    using TracedBufReader = BasicBufReader<detail::TraceReader<detail::BufReader, T>>;
+
+    /**
+     * @brief `ReadAheadReader` that reports the phases of its reads to a tracer, see `linr::TracedBufReader`.
+     */
+    template <Tracer T>
+    using TracedReadAheadReader = BasicBufReader<detail::TraceReader<detail::ReadAheadReader, T>>;
+
+#if defined(LINR_POSIX)
+    /**
+     * @brief `FdReader` that reports the phases of its reads to a tracer, see `linr::TracedBufReader`.
+     */
+    template <Tracer T>
+    using TracedFdReader = BasicBufReader<detail::TraceReader<detail::FdReader, T>, int>;
+
+    /**
+     * @brief `MappedReader` that reports the phases of its reads to a tracer, see `linr::TracedBufReader`.
+     */
+    template <Tracer T>
+    using TracedMappedReader = BasicBufReader<detail::TraceReader<detail::MappedReader, T>>;
+#endif
 }
 
 #endif /* end of include guard: LINR_BUF_READER_HPP */
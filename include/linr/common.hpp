@@ -1,11 +1,15 @@
 #ifndef LINR_COMMON_HPP
 #define LINR_COMMON_HPP
 
+#include <array>
 #include <cstdint>
+#include <memory_resource>
 #include <optional>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #if defined(__cpp_lib_expected)
 #    include <expected>
@@ -139,6 +143,51 @@ namespace linr
     template <typename T, std::size_t N>
     using AResults = Result<Arr<T, N>>;
 
+    /**
+     * @brief Context handed to the parsers.
+     *
+     * `resource` is where allocator-aware values (like `std::pmr::string`) allocate from, null means
+     * `std::pmr::get_default_resource()`. Point it to an arena (e.g. `std::pmr::monotonic_buffer_resource`)
+     * to release all the values of a batch at once.
+     */
+    struct ParseContext
+    {
+        std::pmr::memory_resource* resource = nullptr;
+
+        std::pmr::memory_resource* memory_resource() const noexcept
+        {
+            return resource != nullptr ? resource : std::pmr::get_default_resource();
+        }
+    };
+
+    /**
+     * @brief Column-oriented storage, one vector per type.
+     */
+    template <typename... Ts>
+    using Columns = Tup<std::vector<Ts>...>;
+
+    /**
+     * @brief Number of rows to reserve in each column up front, see `BasicBufReader::read_columns`.
+     *
+     * A type of its own so that it can't be mixed up with the delimiter, a `char` doesn't convert to it.
+     */
+    struct Reserve
+    {
+        std::size_t rows = 0;
+    };
+
+    /**
+     * @brief Outcome of a batch read.
+     *
+     * `count` is the number of lines read and stored, `error` is the error that stopped the batch before it
+     * reached its line limit (if any).
+     */
+    struct BatchResult
+    {
+        std::size_t count;
+        Opt<Error>  error;
+    };
+
     template <typename T, typename... Args>
     Result<T> make_result(Args&&... args) noexcept
     {
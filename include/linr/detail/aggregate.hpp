@@ -0,0 +1,204 @@
+#ifndef LINR_DETAIL_AGGREGATE_HPP
+#define LINR_DETAIL_AGGREGATE_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace linr::detail
+{
+    /**
+     * @brief Converts to anything but `T`, stands for one field when probing the initialization of `T`.
+     */
+    template <typename T>
+    struct AnyField
+    {
+        template <typename U>
+            requires (not std::same_as<std::remove_cvref_t<U>, T>)
+        operator U() const noexcept;
+    };
+
+    /**
+     * @brief Converts to anything but a class, the first probe of a field in braces.
+     *
+     * Converting to classes as well would make `{ AnyField<T>{} }` ambiguous for a class constructible from
+     * a scalar (e.g. `std::string_view`): its copy constructor would be viable too.
+     */
+    struct AnyScalar
+    {
+        template <typename U>
+            requires (not std::is_class_v<U>)
+        operator U() const noexcept;
+    };
+
+    /**
+     * @brief Converts to any class but `T`, the second probe of a field in braces.
+     */
+    template <typename T>
+    struct AnyClass
+    {
+        template <typename U>
+            requires std::is_class_v<U> and (not std::same_as<std::remove_cv_t<U>, T>)
+        operator U() const noexcept;
+    };
+
+    /**
+     * @brief Converts to the base classes of `T` only.
+     */
+    template <typename T>
+    struct AnyBase
+    {
+        template <typename U>
+            requires std::is_base_of_v<U, T> and (not std::same_as<std::remove_cv_t<U>, T>)
+        operator U() const noexcept;
+    };
+
+    template <typename T, std::size_t... Is>
+    constexpr bool brace_constructible(std::index_sequence<Is...>) noexcept
+    {
+        return requires { T{ (void(Is), AnyField<T>{})... }; };
+    }
+
+    template <typename T, typename... Fs>
+    constexpr bool braced_constructible() noexcept
+    {
+        return requires { T{ { Fs{} }... }; };
+    }
+
+    /**
+     * @brief Maximum number of fields of an aggregate that can be read without a `CustomParser`.
+     */
+    inline constexpr std::size_t max_aggregate_fields = 16;
+
+    /**
+     * @brief Number of fields of an aggregate, found by initializing it with more and more fields.
+     *
+     * Each field is initialized from its own braces, which rules out brace elision: an array or an aggregate
+     * field counts as one field. A base class counts as a field too, see `has_base`.
+     */
+    template <typename T, typename... Fs>
+    consteval std::size_t field_count() noexcept
+    {
+        if constexpr (sizeof...(Fs) > max_aggregate_fields) {
+            return sizeof...(Fs);
+        } else if constexpr (braced_constructible<T, Fs..., AnyScalar>()) {
+            return field_count<T, Fs..., AnyScalar>();
+        } else if constexpr (braced_constructible<T, Fs..., AnyClass<T>>()) {
+            return field_count<T, Fs..., AnyClass<T>>();
+        } else {
+            return sizeof...(Fs);
+        }
+    }
+
+    /**
+     * @brief Number of values an aggregate can be initialized with, the elements of its array fields count
+     * one by one since they are initialized through brace elision.
+     *
+     * It matches `field_count` only when no field is an array and every field could be probed.
+     */
+    template <typename T, std::size_t N = 0>
+    consteval std::size_t flat_field_count() noexcept
+    {
+        if constexpr (N > max_aggregate_fields) {
+            return N;
+        } else if constexpr (not brace_constructible<T>(std::make_index_sequence<N + 1>{})) {
+            return N;
+        } else {
+            return flat_field_count<T, N + 1>();
+        }
+    }
+
+    /**
+     * @brief Whether an aggregate has a base class, its first initializer then converts to that base.
+     *
+     * Structured bindings can't decompose a class whose fields are spread over a base and itself, and an
+     * empty base still takes an initializer, so the fields can't be counted either way.
+     */
+    template <typename T>
+    consteval bool has_base() noexcept
+    {
+        return requires { T{ AnyBase<T>{} }; };
+    }
+
+    /**
+     * @brief Tuple of references to the fields of an aggregate, in declaration order.
+     */
+    template <typename T>
+    constexpr auto tie_fields(T& value) noexcept
+    {
+        constexpr auto N = field_count<std::remove_cv_t<T>>();
+        static_assert(N >= 1 and N <= max_aggregate_fields);
+
+        if constexpr (N == 1) {
+            auto& [f0] = value;
+            return std::tie(f0);
+        } else if constexpr (N == 2) {
+            auto& [f0, f1] = value;
+            return std::tie(f0, f1);
+        } else if constexpr (N == 3) {
+            auto& [f0, f1, f2] = value;
+            return std::tie(f0, f1, f2);
+        } else if constexpr (N == 4) {
+            auto& [f0, f1, f2, f3] = value;
+            return std::tie(f0, f1, f2, f3);
+        } else if constexpr (N == 5) {
+            auto& [f0, f1, f2, f3, f4] = value;
+            return std::tie(f0, f1, f2, f3, f4);
+        } else if constexpr (N == 6) {
+            auto& [f0, f1, f2, f3, f4, f5] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5);
+        } else if constexpr (N == 7) {
+            auto& [f0, f1, f2, f3, f4, f5, f6] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6);
+        } else if constexpr (N == 8) {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+        } else if constexpr (N == 9) {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+        } else if constexpr (N == 10) {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+        } else if constexpr (N == 11) {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+        } else if constexpr (N == 12) {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+        } else if constexpr (N == 13) {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+        } else if constexpr (N == 14) {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+        } else if constexpr (N == 15) {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14);
+        } else if constexpr (N == 16) {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = value;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15);
+        }
+    }
+
+    template <typename>
+    struct FieldTypesOf;
+
+    template <typename... Fs>
+    struct FieldTypesOf<std::tuple<Fs&...>>
+    {
+        using Type = std::tuple<std::remove_cv_t<Fs>...>;
+    };
+
+    /**
+     * @brief The types of the fields of an aggregate, as a tuple.
+     */
+    template <typename T>
+    using FieldTypes = typename FieldTypesOf<decltype(tie_fields(std::declval<T&>()))>::Type;
+
+    template <typename T, std::size_t I>
+    using FieldType = std::tuple_element_t<I, FieldTypes<T>>;
+}
+
+#endif /* end of include guard: LINR_DETAIL_AGGREGATE_HPP */
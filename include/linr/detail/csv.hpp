@@ -0,0 +1,226 @@
+#ifndef LINR_DETAIL_CSV_HPP
+#define LINR_DETAIL_CSV_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/line_reader.hpp"
+#include "linr/detail/read.hpp"
+#include "linr/parser.hpp"
+
+#include <algorithm>
+#include <span>
+#include <string>
+
+namespace linr::detail
+{
+    /**
+     * @brief Buffers of the CSV reader, reused across records.
+     */
+    struct CsvBuffers
+    {
+        std::string m_record;       // record that spans physical lines, joined with '\n'
+        std::string m_unescaped;    // quoted fields that contain escaped quotes, back to back
+    };
+
+    /**
+     * @brief Whether a physical line ends inside a quoted field, i.e. the record continues on the next line.
+     *
+     * A quote in the middle of an unquoted field makes the record invalid, it doesn't open a quoted field.
+     *
+     * @param str The physical line.
+     * @param delim The delimiter.
+     * @param in_quotes Whether the line starts inside a quoted field.
+     */
+    inline bool ends_in_quotes(Str str, char delim, bool in_quotes) noexcept
+    {
+        auto field_start = not in_quotes;
+        auto after_close = false;    // `""` in a quoted field reopens it
+
+        for (auto c : str) {
+            if (in_quotes) {
+                in_quotes   = c != '"';
+                after_close = not in_quotes;
+            } else if (c == '"') {
+                if (not field_start and not after_close) {
+                    return false;
+                }
+                in_quotes   = true;
+                field_start = false;
+            } else {
+                field_start = c == delim;
+                after_close = false;
+            }
+        }
+
+        return in_quotes;
+    }
+
+    /**
+     * @brief Split a record without quotes into exactly `N` fields, empty fields included.
+     */
+    template <std::size_t N>
+    bool split_csv_plain(Str record, char delim, std::span<Str, N> fields) noexcept
+    {
+        auto pos = std::size_t{ 0 };
+        for (auto i = 0u; i + 1 < N; ++i) {
+            auto next = record.find(delim, pos);
+            if (next == Str::npos) {
+                return false;
+            }
+            fields[i] = record.substr(pos, next - pos);
+            pos       = next + 1;
+        }
+
+        fields[N - 1] = record.substr(pos);
+        return fields[N - 1].find(delim) == Str::npos;
+    }
+
+    /**
+     * @brief Split a record that contains quotes into exactly `N` fields.
+     *
+     * A quoted field is a view inside its quotes, unless it contains escaped quotes (`""`): those fields are
+     * unescaped into `unescaped`, which must have room for the whole record so it never reallocates while
+     * the fields refer to it. A quote in an unquoted field or text after a closing quote is an error.
+     */
+    template <std::size_t N>
+    bool split_csv_quoted(Str record, char delim, std::string& unescaped, std::span<Str, N> fields) noexcept
+    {
+        auto pos = std::size_t{ 0 };
+
+        for (auto i = 0u; i < N; ++i) {
+            if (i != 0) {
+                if (pos == record.size() or record[pos] != delim) {
+                    return false;
+                }
+                ++pos;
+            }
+
+            if (pos == record.size() or record[pos] != '"') {
+                auto next = std::min(record.find(delim, pos), record.size());
+                fields[i] = record.substr(pos, next - pos);
+                if (fields[i].find('"') != Str::npos) {
+                    return false;
+                }
+                pos = next;
+                continue;
+            }
+
+            auto first = ++pos;
+            auto close = record.find('"', first);
+            if (close == Str::npos) {
+                return false;
+            }
+            if (close + 1 == record.size() or record[close + 1] != '"') {
+                fields[i] = record.substr(first, close - first);
+                pos       = close + 1;
+                continue;
+            }
+
+            // escaped quotes, copy the runs between them
+            auto begin = unescaped.size();
+            while (close + 1 != record.size() and record[close + 1] == '"') {
+                unescaped.append(record.substr(first, close + 1 - first));
+                first = close + 2;
+                close = record.find('"', first);
+                if (close == Str::npos) {
+                    return false;
+                }
+            }
+            unescaped.append(record.substr(first, close - first));
+
+            fields[i] = Str{ unescaped }.substr(begin);
+            pos       = close + 1;
+        }
+
+        return pos == record.size();
+    }
+
+    template <Parseable... Ts, typename S, LineReader<S> R>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    Results<Ts...> read_csv_impl(
+        S                   stream,
+        R&                  reader,
+        CsvBuffers&         buffers,
+        char                delim,
+        const ParseContext& context = {}
+    ) noexcept
+    {
+        constexpr auto count = sizeof...(Ts);
+
+        if (stream_error(stream, reader)) {
+            return make_error<Tup<Ts...>>(Error::Unknown);
+        }
+
+        auto line = reader.readline(stream);
+        if (not line) {
+            auto error = stream_error(stream, reader) ? Error::Unknown : Error::EndOfFile;
+            return make_error<Tup<Ts...>>(error);
+        }
+
+        auto probe  = probe_of(reader);
+        auto record = line_view(line->view());
+
+        const auto parse_fields = [&](Arr<Str, count>& fields) {
+            return parse_into_tuple<Ts...>(fields, context);
+        };
+
+        // fast path: no quote, no escaping, the record is the line
+        if (record.find('"') == Str::npos) {
+            if (record.ends_with('\r')) {
+                record.remove_suffix(1);
+            }
+
+            const auto split_plain = [&] {
+                auto fields = Opt<Arr<Str, count>>{ std::in_place };
+                if (not split_csv_plain<count>(record, delim, *fields)) {
+                    fields.reset();
+                }
+                return fields;
+            };
+            return split_and_parse<Tup<Ts...>>(record, probe, split_plain, parse_fields);
+        }
+
+        // a newline inside a quoted field continues the record on the next line
+        if (ends_in_quotes(record, delim, false)) {
+            try {
+                buffers.m_record.assign(record);
+                for (auto open = true; open;) {
+                    line = reader.readline(stream);
+                    if (not line) {
+                        auto error = stream_error(stream, reader) ? Error::Unknown : Error::InvalidInput;
+                        return make_error<Tup<Ts...>>(error);
+                    }
+
+                    auto next = line_view(line->view());
+                    buffers.m_record.push_back('\n');
+                    buffers.m_record.append(next);
+                    open = ends_in_quotes(next, delim, true);
+                }
+            } catch (...) {
+                return make_error<Tup<Ts...>>(Error::Unknown);
+            }
+            record = buffers.m_record;
+        }
+
+        if (record.ends_with('\r')) {
+            record.remove_suffix(1);
+        }
+
+        try {
+            buffers.m_unescaped.clear();
+            buffers.m_unescaped.reserve(record.size());
+        } catch (...) {
+            return make_error<Tup<Ts...>>(Error::Unknown);
+        }
+
+        const auto split_quoted = [&] {
+            auto fields = Opt<Arr<Str, count>>{ std::in_place };
+            if (not split_csv_quoted<count>(record, delim, buffers.m_unescaped, *fields)) {
+                fields.reset();
+            }
+            return fields;
+        };
+        return split_and_parse<Tup<Ts...>>(record, probe, split_quoted, parse_fields);
+    }
+}
+
+#endif /* end of include guard: LINR_DETAIL_CSV_HPP */
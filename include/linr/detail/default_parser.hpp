@@ -2,10 +2,15 @@
 #define LINR_DETAIL_DEFAULT_PARSER_HPP
 
 #include "linr/common.hpp"
+#include "linr/detail/enum_parser.hpp"
+#include "linr/detail/parse_float.hpp"
+#include "linr/detail/parse_int.hpp"
 
 #include <array>
 #include <cctype>
 #include <charconv>
+#include <concepts>
+#include <memory_resource>
 #include <string>
 
 namespace linr::detail
@@ -54,9 +59,31 @@ namespace linr::detail
         }
     };
 
-    // specialization for fundamental types
+    // specialization for integer types
+    template <Integer T>
+    struct DefaultParser<T>
+    {
+        Result<T> parse(Str str) const noexcept { return parse_integer<T>(str); }
+    };
+
+#if not defined(LINR_DISABLE_FAST_FLOAT)
     template <typename T>
-        requires std::is_fundamental_v<T>
+    concept FastFloatParseable = FastFloat<T>;
+#else
+    template <typename T>
+    concept FastFloatParseable = false;
+#endif
+
+    // specialization for float and double (define `LINR_DISABLE_FAST_FLOAT` to use `std::from_chars`)
+    template <FastFloatParseable T>
+    struct DefaultParser<T>
+    {
+        Result<T> parse(Str str) const noexcept { return parse_float<T>(str); }
+    };
+
+    // specialization for the rest of fundamental types
+    template <typename T>
+        requires std::is_fundamental_v<T> and (not Integer<T>) and (not FastFloatParseable<T>)
     struct DefaultParser<T>
     {
         Result<T> parse(Str str) const noexcept
@@ -74,6 +101,13 @@ namespace linr::detail
         }
     };
 
+    // specialization for enums with registered names (see `linr::EnumNames`)
+    template <NamedEnum E>
+    struct DefaultParser<E>
+    {
+        Result<E> parse(Str str) const noexcept { return EnumTable<E>::find(str); }
+    };
+
     // specialization for std::string
     template <>
     struct DefaultParser<std::string>
@@ -83,6 +117,31 @@ namespace linr::detail
             return make_result<std::string>(str.begin(), str.size());
         }
     };
+
+    // specialization for std::pmr::string, allocated from the memory resource of the context
+    template <>
+    struct DefaultParser<std::pmr::string>
+    {
+        Result<std::pmr::string> parse(Str str, const ParseContext& context) const noexcept
+        {
+            return make_result<std::pmr::string>(str.begin(), str.size(), context.memory_resource());
+        }
+    };
+
+    /**
+     * @brief Types whose parsed value refers to the line buffer instead of owning its data.
+     *
+     * These are only valid until the next read, so they can only be read from a reader that keeps its buffer.
+     */
+    template <typename T>
+    concept Borrowed = std::same_as<T, Str>;
+
+    // specialization for std::string_view, the view refers to the line buffer of the reader
+    template <>
+    struct DefaultParser<Str>
+    {
+        Result<Str> parse(Str str) const noexcept { return make_result<Str>(str); }
+    };
 }
 
 #endif /* end of include guard: LINR_DETAIL_DEFAULT_PARSER_HPP */
@@ -0,0 +1,217 @@
+#ifndef LINR_DETAIL_ENUM_PARSER_HPP
+#define LINR_DETAIL_ENUM_PARSER_HPP
+
+#include "linr/common.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace linr
+{
+    /**
+     * @brief Customization point for parsing an enum by the names of its enumerators.
+     *
+     * @tparam E The enum type.
+     *
+     * Specialize it with a `static constexpr` array named `names` of pairs of name and enumerator, and
+     * optionally a `static constexpr bool case_insensitive` (ASCII only, defaults to `false`):
+     *
+     * ```cpp
+     * template <>
+     * struct linr::EnumNames<Color>
+     * {
+     *     static constexpr auto names = std::to_array<std::pair<linr::Str, Color>>({
+     *         { "red", Color::Red },
+     *         { "green", Color::Green },
+     *     });
+     *     static constexpr bool case_insensitive = true;
+     * };
+     * ```
+     *
+     * `parse<Color>` then looks the token up in a perfect hash table built at compile time: one hash of the
+     * token and one string comparison.
+     */
+    template <typename E>
+    struct EnumNames;
+}
+
+namespace linr::detail
+{
+    template <typename E>
+    concept NamedEnum = std::is_enum_v<E> and requires {
+        { std::size(EnumNames<E>::names) } -> std::convertible_to<std::size_t>;
+        { EnumNames<E>::names[0].first } -> std::convertible_to<Str>;
+        { EnumNames<E>::names[0].second } -> std::convertible_to<E>;
+    };
+
+    template <bool CaseInsensitive>
+    constexpr char fold_case(char c) noexcept
+    {
+        if constexpr (CaseInsensitive) {
+            return c >= 'A' and c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+        } else {
+            return c;
+        }
+    }
+
+    template <bool CaseInsensitive>
+    constexpr bool equal_names(Str lhs, Str rhs) noexcept
+    {
+        if constexpr (CaseInsensitive) {
+            return std::ranges::equal(lhs, rhs, {}, fold_case<true>, fold_case<true>);
+        } else {
+            return lhs == rhs;
+        }
+    }
+
+    // FNV-1a
+    template <bool CaseInsensitive>
+    constexpr std::uint64_t hash_name(Str name) noexcept
+    {
+        auto hash = std::uint64_t{ 0xCBF2'9CE4'8422'2325 };
+        for (auto c : name) {
+            hash ^= static_cast<unsigned char>(fold_case<CaseInsensitive>(c));
+            hash *= 0x0000'0100'0000'01B3;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Perfect hash table from the names of an enum to its enumerators, built at compile time.
+     *
+     * Hash and displace: the upper half of the hash picks a bucket, each bucket stores a displacement that
+     * was searched so that every name of the bucket lands in a distinct slot (the slot is a mix of the hash
+     * and the displacement). Lookup is one hash of the token, two table loads, and one comparison.
+     */
+    template <NamedEnum E>
+    class EnumTable
+    {
+    public:
+        static Result<E> find(Str str) noexcept
+        {
+            auto hash  = hash_name<case_insensitive>(str);
+            auto entry = s_table.m_slots[slot(hash, s_table.m_displacements[bucket(hash)])];
+
+            if (entry != 0 and equal_names<case_insensitive>(str, names[entry - 1].first)) {
+                return make_result<E>(static_cast<E>(names[entry - 1].second));
+            }
+            return make_error<E>(Error::InvalidInput);
+        }
+
+    private:
+        static constexpr auto& names = EnumNames<E>::names;
+
+        static constexpr bool case_insensitive = [] {
+            if constexpr (requires { EnumNames<E>::case_insensitive; }) {
+                return static_cast<bool>(EnumNames<E>::case_insensitive);
+            } else {
+                return false;
+            }
+        }();
+
+        static constexpr std::size_t count        = std::size(names);
+        static constexpr std::size_t bucket_count = std::max(count / 2, std::size_t{ 1 });
+        static constexpr std::size_t slot_count   = std::bit_ceil(std::max(count * 2, std::size_t{ 2 }));
+        static constexpr int         slot_shift   = 64 - std::countr_zero(slot_count);
+
+        static_assert(count > 0, "EnumNames::names must not be empty");
+        static_assert(count < 0xFFFF, "EnumNames::names has too many names");
+
+        struct Table
+        {
+            Arr<std::uint32_t, bucket_count> m_displacements;
+            Arr<std::uint16_t, slot_count>   m_slots;    // index into `names` plus one, 0 for an empty slot
+        };
+
+        static constexpr std::size_t bucket(std::uint64_t hash) noexcept
+        {
+            return static_cast<std::size_t>((hash >> 32) % bucket_count);
+        }
+
+        static constexpr std::size_t slot(std::uint64_t hash, std::uint32_t displacement) noexcept
+        {
+            return static_cast<std::size_t>(((hash ^ displacement) * 0x9E37'79B9'7F4A'7C15) >> slot_shift);
+        }
+
+        static constexpr bool has_duplicates() noexcept
+        {
+            for (auto i = 0u; i < count; ++i) {
+                for (auto j = i + 1; j < count; ++j) {
+                    if (equal_names<case_insensitive>(names[i].first, names[j].first)) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        static_assert(not has_duplicates(), "EnumNames::names has duplicate names");
+
+        static constexpr Table build() noexcept
+        {
+            auto table  = Table{ {}, {} };
+            auto hashes = Arr<std::uint64_t, count>{};
+            auto order  = Arr<std::size_t, count>{};
+
+            for (auto i = 0u; i < count; ++i) {
+                hashes[i] = hash_name<case_insensitive>(names[i].first);
+                order[i]  = i;
+            }
+
+            // place the largest buckets first, while the table is still mostly empty
+            auto sizes = Arr<std::size_t, bucket_count>{};
+            for (auto hash : hashes) {
+                ++sizes[bucket(hash)];
+            }
+            std::ranges::sort(order, [&](std::size_t lhs, std::size_t rhs) {
+                auto lhs_bucket = bucket(hashes[lhs]);
+                auto rhs_bucket = bucket(hashes[rhs]);
+                if (sizes[lhs_bucket] != sizes[rhs_bucket]) {
+                    return sizes[lhs_bucket] > sizes[rhs_bucket];
+                }
+                return lhs_bucket < rhs_bucket or (lhs_bucket == rhs_bucket and lhs < rhs);
+            });
+
+            for (auto first = 0u; first < count;) {
+                auto current = bucket(hashes[order[first]]);
+                auto last    = first;
+                while (last < count and bucket(hashes[order[last]]) == current) {
+                    ++last;
+                }
+
+                for (auto displacement = std::uint32_t{ 0 };; ++displacement) {
+                    auto slots = Arr<std::size_t, count>{};
+                    auto fits  = true;
+
+                    for (auto i = first; i < last and fits; ++i) {
+                        slots[i - first] = slot(hashes[order[i]], displacement);
+                        fits             = table.m_slots[slots[i - first]] == 0;
+                        for (auto j = first; j < i and fits; ++j) {
+                            fits = slots[j - first] != slots[i - first];
+                        }
+                    }
+
+                    if (fits) {
+                        for (auto i = first; i < last; ++i) {
+                            table.m_slots[slots[i - first]] = static_cast<std::uint16_t>(order[i] + 1);
+                        }
+                        table.m_displacements[current] = displacement;
+                        break;
+                    }
+                }
+
+                first = last;
+            }
+
+            return table;
+        }
+
+        static constexpr Table s_table = build();
+    };
+}
+
+#endif /* end of include guard: LINR_DETAIL_ENUM_PARSER_HPP */
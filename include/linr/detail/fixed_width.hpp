@@ -0,0 +1,141 @@
+#ifndef LINR_DETAIL_FIXED_WIDTH_HPP
+#define LINR_DETAIL_FIXED_WIDTH_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/line_reader.hpp"
+#include "linr/detail/read.hpp"
+#include "linr/parser.hpp"
+
+#include <cstddef>
+#include <span>
+
+namespace linr
+{
+    /**
+     * @brief A column of a fixed-width record: `width` bytes starting at byte `offset` of the line.
+     */
+    struct FixedColumn
+    {
+        std::size_t offset;
+        std::size_t width;
+    };
+
+    /**
+     * @brief Layout of a fixed-width record, one column per value.
+     *
+     * Usable as a template argument, so the offsets can be compile-time constants.
+     */
+    template <std::size_t N>
+    struct FixedLayout
+    {
+        Arr<FixedColumn, N> columns;
+        bool                trim = true;    // remove the spaces padding each field
+    };
+
+    /**
+     * @brief Make a fixed-width layout, e.g. `fixed_layout({ { 0, 8 }, { 8, 12 } })`.
+     *
+     * @param columns The columns, in the order of the values.
+     * @param trim Whether to remove the spaces padding each field.
+     */
+    template <std::size_t N>
+    constexpr FixedLayout<N> fixed_layout(const FixedColumn (&columns)[N], bool trim = true) noexcept
+    {
+        auto layout = FixedLayout<N>{ {}, trim };
+        for (auto i = 0u; i < N; ++i) {
+            layout.columns[i] = columns[i];
+        }
+        return layout;
+    }
+}
+
+namespace linr::detail
+{
+    constexpr Str trim_padding(Str str) noexcept
+    {
+        auto first = str.find_first_not_of(' ');
+        if (first == Str::npos) {
+            return {};
+        }
+        return str.substr(first, str.find_last_not_of(' ') + 1 - first);
+    }
+
+    /**
+     * @brief Cut a line into the fields of a fixed-width layout, without looking at its content.
+     *
+     * A column past the end of the line is cut short (or empty), as exports often drop trailing padding.
+     */
+    template <std::size_t N>
+    constexpr void slice_fixed(Str line, const FixedLayout<N>& layout, std::span<Str, N> fields) noexcept
+    {
+        line = line_view(line);
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+
+        for (auto i = 0u; i < N; ++i) {
+            auto [offset, width] = layout.columns[i];
+
+            auto field = offset < line.size() ? line.substr(offset, width) : Str{};
+            fields[i]  = layout.trim ? trim_padding(field) : field;
+        }
+    }
+}
+
+namespace linr
+{
+    /**
+     * @brief Parse a fixed-width record into a tuple.
+     *
+     * @param line The line.
+     * @param layout The columns of the record, one per type.
+     * @param context The parse context.
+     */
+    template <Parseable... Ts>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    Results<Ts...> parse_fixed(
+        Str                               line,
+        const FixedLayout<sizeof...(Ts)>& layout,
+        const ParseContext&               context = {}
+    ) noexcept
+    {
+        auto fields = Arr<Str, sizeof...(Ts)>{};
+        detail::slice_fixed<sizeof...(Ts)>(line, layout, fields);
+        return parse_into_tuple<Ts...>(fields, context);
+    }
+}
+
+namespace linr::detail
+{
+    template <Parseable... Ts, typename S, LineReader<S> R>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    Results<Ts...> read_fixed_impl(
+        S                                 stream,
+        R&                                reader,
+        const FixedLayout<sizeof...(Ts)>& layout,
+        const ParseContext&               context = {}
+    ) noexcept
+    {
+        if (stream_error(stream, reader)) {
+            return make_error<Tup<Ts...>>(Error::Unknown);
+        }
+
+        auto line = reader.readline(stream);
+        if (not line) {
+            auto error = stream_error(stream, reader) ? Error::Unknown : Error::EndOfFile;
+            return make_error<Tup<Ts...>>(error);
+        }
+
+        const auto slice = [&] {
+            auto fields = Opt<Arr<Str, sizeof...(Ts)>>{ std::in_place };
+            slice_fixed<sizeof...(Ts)>(line->view(), layout, *fields);
+            return fields;
+        };
+        const auto parse_fields = [&](Arr<Str, sizeof...(Ts)>& fields) {
+            return parse_into_tuple<Ts...>(fields, context);
+        };
+        return split_and_parse<Tup<Ts...>>(line->view(), probe_of(reader), slice, parse_fields);
+    }
+}
+
+#endif /* end of include guard: LINR_DETAIL_FIXED_WIDTH_HPP */
@@ -0,0 +1,113 @@
+#ifndef LINR_DETAIL_LINE_RANGE_HPP
+#define LINR_DETAIL_LINE_RANGE_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/read.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+
+namespace linr::detail
+{
+    /**
+     * @brief Input range that reads and parses one line per increment.
+     *
+     * Every line yields a `Results<Ts...>`, parse errors included. The range ends at `Error::EndOfFile`,
+     * which is not yielded; any other stream error is yielded once and then ends the range. The range only
+     * refers to the reader, so the reader must outlive it.
+     */
+    template <typename S, typename R, Parseable... Ts>
+        requires LineReader<R, S> and (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    class LineRange : public std::ranges::view_interface<LineRange<S, R, Ts...>>
+    {
+    public:
+        class Iterator
+        {
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using difference_type  = std::ptrdiff_t;
+            using value_type       = Results<Ts...>;
+
+            Iterator() = default;
+
+            explicit Iterator(LineRange* range) noexcept
+                : m_range{ range }
+            {
+            }
+
+            value_type& operator*() const noexcept { return *m_range->current(); }
+
+            Iterator& operator++() noexcept
+            {
+                m_range->m_stale = true;
+                return *this;
+            }
+
+            void operator++(int) noexcept { ++*this; }
+
+            friend bool operator==(const Iterator& iter, std::default_sentinel_t) noexcept
+            {
+                return iter.done();
+            }
+
+        private:
+            bool done() const noexcept { return not m_range->current().has_value(); }
+
+            LineRange* m_range = nullptr;
+        };
+
+        LineRange(S stream, R& reader, char delim, ParseContext context) noexcept
+            : m_stream{ stream }
+            , m_reader{ &reader }
+            , m_delim{ delim }
+            , m_context{ context }
+        {
+        }
+
+        /**
+         * @brief Get an iterator to the first unread line, call only once.
+         */
+        Iterator begin() noexcept { return Iterator{ this }; }
+
+        std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+    private:
+        // the line is read on access rather than on increment, so an adaptor that stops after `n` elements
+        // (like `std::views::take`) doesn't consume one line too many
+        Opt<Results<Ts...>>& current() noexcept
+        {
+            if (m_stale) {
+                m_stale = false;
+                fetch();
+            }
+            return m_current;
+        }
+
+        void fetch() noexcept
+        {
+            // a stream error is unrecoverable, stop right after it's been yielded
+            if (m_current.has_value() and not *m_current and is_stream_error(m_current->error())) {
+                m_current.reset();
+                return;
+            }
+
+            auto result = read_impl<Ts...>(m_stream, *m_reader, std::nullopt, m_delim, m_context);
+            if (not result and result.error() == Error::EndOfFile) {
+                m_current.reset();
+                return;
+            }
+
+            m_current.emplace(std::move(result));
+        }
+
+        S                   m_stream;
+        R*                  m_reader;
+        char                m_delim;
+        ParseContext        m_context;
+        Opt<Results<Ts...>> m_current;
+        bool                m_stale = true;
+    };
+}
+
+#endif /* end of include guard: LINR_DETAIL_LINE_RANGE_HPP */
@@ -2,13 +2,26 @@
 #define LINR_READER_HPP
 
 #include "linr/common.hpp"
+#include "linr/detail/simd.hpp"
 
+#include <algorithm>
+#include <cerrno>
 #include <concepts>
 #include <cstdio>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <span>
 #include <utility>
 #include <vector>
 
+#if defined(__unix__) or defined(__APPLE__)
+#    define LINR_POSIX
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
 namespace linr::detail
 {
     template <typename L>
@@ -16,14 +29,67 @@ namespace linr::detail
         { l.view() } noexcept -> std::same_as<Str>;
     };
 
-    template <typename R>
-    concept LineReader = requires (R r, std::FILE* f) {
+    template <typename R, typename S = std::FILE*>
+    concept LineReader = requires (R r, S s) {
         typename R::Line;
         requires Line<typename R::Line>;
 
-        { r.readline(f) } noexcept -> std::same_as<Opt<typename R::Line>>;
+        { r.readline(s) } noexcept -> std::same_as<Opt<typename R::Line>>;
     };
 
+    /**
+     * @brief The text of a line read by a line reader, without the null character that the `getline`
+     * readers leave in place of the newline.
+     */
+    constexpr Str line_view(Str line) noexcept
+    {
+        if (line.ends_with('\0')) {
+            line.remove_suffix(1);
+        }
+        return line;
+    }
+
+    /**
+     * @brief Get the stream that refers to the standard input.
+     *
+     * @tparam S The stream type.
+     */
+    template <typename S>
+    S default_stream() noexcept;
+
+    template <>
+    inline std::FILE* default_stream<std::FILE*>() noexcept
+    {
+        return stdin;
+    }
+
+#if defined(LINR_POSIX)
+    template <>
+    inline int default_stream<int>() noexcept
+    {
+        return STDIN_FILENO;
+    }
+#endif
+
+    /**
+     * @brief Check whether the stream is in an error state.
+     *
+     * Readers that bypass stdio keep track of their own error state and expose it through an `error()`
+     * member function, otherwise the error indicator of the `std::FILE*` is used.
+     *
+     * @param stream The stream the reader reads from.
+     * @param reader The line reader.
+     */
+    template <typename S, typename R>
+    bool stream_error(S stream, const R& reader) noexcept
+    {
+        if constexpr (requires { { reader.error() } noexcept -> std::same_as<bool>; }) {
+            return reader.error();
+        } else {
+            return std::ferror(stream) != 0;
+        }
+    }
+
 #if defined(__GLIBC__) and defined(LINR_ENABLE_GETLINE)
     struct GetlineReader
     {
@@ -125,6 +191,8 @@ namespace linr::detail
             return Opt<Line>{ std::in_place, m_buf, static_cast<std::size_t>(nread) };
         }
 
+        std::size_t capacity() const noexcept { return m_size; }
+
         using Ptr = std::unique_ptr<char, decltype(&free)>;
 
         char*       m_buf  = nullptr;
@@ -184,7 +252,7 @@ namespace linr::detail
         };
 
         BufFgetsReader(std::size_t size)
-            : m_buf(size, '\0')
+            : m_buf(std::max(size, std::size_t{ 2 }), '\0')
         {
         }
 
@@ -198,35 +266,354 @@ namespace linr::detail
 
         Opt<Line> readline(std::FILE* stream) noexcept
         {
-            std::ranges::fill(m_buf, '\0');
-
             std::size_t offset = 0;
-            bool        first  = true;
             while (true) {
-                auto res = std::fgets(m_buf.data() + offset, static_cast<int>(m_buf.size() - offset), stream);
-                if (res == nullptr and first) {
-                    return {};
+                auto* data = m_buf.data();
+                auto  size = m_buf.size();
+
+                // sentinel, only overwritten by a non-null character if fgets fills the whole buffer
+                data[size - 2] = '\0';
+
+                auto res = std::fgets(data + offset, static_cast<int>(size - offset), stream);
+                if (res == nullptr) {
+                    if (offset == 0) {
+                        return {};
+                    }
+                    break;    // EOF right after the buffer was filled, the line ends at offset
                 }
 
-                first = false;
-
                 // fgets encountered newline or EOF
-                if (auto last = m_buf[m_buf.size() - 2]; last == '\0' or last == '\n') {
+                if (auto last = data[size - 2]; last == '\0' or last == '\n') {
+                    offset = static_cast<std::size_t>(simd::find_line_end(data + offset, data + size) - data);
                     break;
                 }
 
                 // fgets reached the limit of the buffer; double the size
-                offset = m_buf.size() - 1;
-                m_buf.resize(m_buf.size() * 2, '\0');
+                offset = size - 1;
+                m_buf.resize(size * 2, '\0');
             }
 
-            return Opt<Line>{ std::in_place, m_buf.data(), m_buf.size() };
+            return Opt<Line>{ std::in_place, m_buf.data(), offset };
         }
 
+        std::size_t capacity() const noexcept { return m_buf.size(); }
+
         std::vector<char> m_buf;
     };
     static_assert(LineReader<BufFgetsReader>);
 
+    /**
+     * @brief Line reader over a buffer that is already in memory, the lines are views into the buffer.
+     *
+     * The buffer is the stream: nothing is copied and there is no system call. Reading starts over from the
+     * beginning of the buffer after `reset()` (which `BasicBufReader::set_stream` calls), even when the
+     * buffer is the same one refilled. The buffer must outlive the lines.
+     */
+    struct SpanReader
+    {
+        struct Line
+        {
+            Line(const char* ptr, std::size_t size)
+                : m_str{ ptr, size }
+            {
+            }
+            Str view() const noexcept { return m_str; }
+            Str m_str;
+        };
+
+        Opt<Line> readline(std::span<const char> buffer) noexcept
+        {
+            if (m_pos >= buffer.size()) {
+                return {};
+            }
+
+            const auto* data  = buffer.data();
+            const auto* begin = data + m_pos;
+            const auto* nl    = simd::find_newline(begin, data + buffer.size());
+            auto        end   = static_cast<std::size_t>(nl - data);
+
+            auto line = Opt<Line>{ std::in_place, begin, end - m_pos };
+            m_pos     = end != buffer.size() ? end + 1 : end;
+
+            return line;
+        }
+
+        // a buffer can't fail, and `std::ferror` doesn't apply to it
+        bool error() const noexcept { return false; }
+
+        // start over from the beginning of the buffer
+        void reset() noexcept { m_pos = 0; }
+
+        std::size_t m_pos = 0;
+    };
+    static_assert(LineReader<SpanReader, std::span<const char>>);
+
+#if defined(LINR_POSIX)
+    /**
+     * @brief Line reader that reads from a file descriptor using `read(2)` directly, bypassing stdio.
+     *
+     * The data is read in chunks into an internal buffer and the lines are handed out as views into that
+     * buffer, valid until the next `readline` call. A line that doesn't fit in the buffer grows it.
+     *
+     * The buffered data is not shared with anything else, mixing this reader with other reads on the same
+     * file descriptor (including a `std::FILE*` opened on it) will lose data.
+     * Call `reset()` before reading another file descriptor, `BasicBufReader::set_stream` does it.
+     */
+    struct FdReader
+    {
+        struct Line
+        {
+            Line(char* ptr, std::size_t size)
+                : m_str{ ptr, size }
+            {
+            }
+            Str view() const noexcept { return m_str; }
+            Str m_str;
+        };
+
+        FdReader(std::size_t size)
+            : m_buf(std::max(size, std::size_t{ 2 }), '\0')
+        {
+        }
+
+        ~FdReader() = default;
+
+        FdReader(FdReader&&)            = default;
+        FdReader& operator=(FdReader&&) = default;
+
+        FdReader(const FdReader&)            = delete;
+        FdReader& operator=(const FdReader&) = delete;
+
+        Opt<Line> readline(int fd) noexcept
+        {
+            // part of [m_begin, m_end) that is already known to not contain a newline
+            auto scanned = m_begin;
+
+            while (true) {
+                auto* data = m_buf.data();
+                auto* nl   = simd::find_newline(data + scanned, data + m_end);
+
+                if (nl != data + m_end) {
+                    auto pos  = static_cast<std::size_t>(nl - data);
+                    auto line = Opt<Line>{ std::in_place, data + m_begin, pos - m_begin };
+                    m_begin   = pos + 1;
+                    return line;
+                }
+
+                if (m_eof) {
+                    if (m_begin == m_end) {
+                        return {};
+                    }
+
+                    // last line without trailing newline
+                    auto line = Opt<Line>{ std::in_place, data + m_begin, m_end - m_begin };
+                    m_begin   = m_end;
+                    return line;
+                }
+
+                // move the partial line to the front, grow the buffer if the line fills it entirely
+                if (m_begin != 0) {
+                    std::memmove(data, data + m_begin, m_end - m_begin);
+                    m_end   -= m_begin;
+                    m_begin  = 0;
+                }
+                if (m_end == m_buf.size()) {
+                    m_buf.resize(m_buf.size() * 2);
+                }
+                scanned = m_end;
+
+                auto nread = fill(fd);
+                if (nread < 0) {
+                    m_error = true;
+                    return {};
+                } else if (nread == 0) {
+                    m_eof = true;
+                }
+                m_end += static_cast<std::size_t>(nread);
+            }
+        }
+
+        bool error() const noexcept { return m_error; }
+
+        // drop the buffered data and the end or error state, the next `readline` reads from its descriptor
+        void reset() noexcept
+        {
+            m_begin = 0;
+            m_end   = 0;
+            m_eof   = false;
+            m_error = false;
+        }
+
+        std::size_t capacity() const noexcept { return m_buf.size(); }
+
+        // number of `read(2)` calls
+        std::uint64_t refills() const noexcept { return m_refills; }
+
+        ssize_t fill(int fd) noexcept
+        {
+            while (true) {
+                ++m_refills;
+                auto nread = ::read(fd, m_buf.data() + m_end, m_buf.size() - m_end);
+                if (nread >= 0 or errno != EINTR) {
+                    return nread;
+                }
+            }
+        }
+
+        std::vector<char> m_buf;
+        std::size_t       m_begin   = 0;    // start of unconsumed data
+        std::size_t       m_end     = 0;    // end of valid data
+        std::uint64_t     m_refills = 0;
+        bool              m_eof     = false;
+        bool              m_error   = false;
+    };
+    static_assert(LineReader<FdReader, int>);
+
+    /**
+     * @brief Line reader that maps a regular file into memory and yields views straight into the mapping.
+     *
+     * The stream is mapped on the first `readline` call (and again after `reset()`, which
+     * `BasicBufReader::set_stream` calls), starting from the current position of the stream. The position of
+     * the stream itself is not advanced. A stream that doesn't refer to a regular file puts the reader into
+     * an error state.
+     */
+    struct MappedReader
+    {
+        struct Line
+        {
+            Line(const char* ptr, std::size_t size)
+                : m_str{ ptr, size }
+            {
+            }
+            Str view() const noexcept { return m_str; }
+            Str m_str;
+        };
+
+        MappedReader() = default;
+
+        ~MappedReader() { unmap(); }
+
+        MappedReader(MappedReader&& other) noexcept
+            : m_data{ std::exchange(other.m_data, nullptr) }
+            , m_size{ std::exchange(other.m_size, 0) }
+            , m_pos{ std::exchange(other.m_pos, 0) }
+            , m_maps{ std::exchange(other.m_maps, 0) }
+            , m_mapped{ std::exchange(other.m_mapped, false) }
+            , m_error{ std::exchange(other.m_error, false) }
+        {
+        }
+
+        MappedReader& operator=(MappedReader&& other) noexcept
+        {
+            if (this == &other) {
+                return *this;
+            }
+
+            unmap();
+
+            m_data   = std::exchange(other.m_data, nullptr);
+            m_size   = std::exchange(other.m_size, 0);
+            m_pos    = std::exchange(other.m_pos, 0);
+            m_maps   = std::exchange(other.m_maps, 0);
+            m_mapped = std::exchange(other.m_mapped, false);
+            m_error  = std::exchange(other.m_error, false);
+
+            return *this;
+        }
+
+        MappedReader(const MappedReader&)            = delete;
+        MappedReader& operator=(const MappedReader&) = delete;
+
+        Opt<Line> readline(std::FILE* stream) noexcept
+        {
+            // the stream is not compared to the mapped one, a new stream may well reuse its address
+            if (not m_mapped and not map(stream)) {
+                return {};
+            }
+
+            if (m_pos == m_size) {
+                return {};
+            }
+
+            auto* begin = m_data + m_pos;
+            auto* nl    = simd::find_newline(begin, m_data + m_size);
+            auto  end   = static_cast<std::size_t>(nl - m_data);
+
+            auto line = Opt<Line>{ std::in_place, begin, end - m_pos };
+            m_pos     = end != m_size ? end + 1 : end;
+
+            return line;
+        }
+
+        bool error() const noexcept { return m_error; }
+
+        // unmap the stream, the next `readline` maps its stream
+        void reset() noexcept
+        {
+            unmap();
+            m_mapped = false;
+            m_error  = false;
+        }
+
+        // number of times a stream was mapped
+        std::uint64_t refills() const noexcept { return m_maps; }
+
+        bool map(std::FILE* stream) noexcept
+        {
+            unmap();
+
+            ++m_maps;
+            m_mapped = true;
+            m_error  = true;
+
+            auto fd   = fileno(stream);
+            struct stat info = {};
+            if (fd < 0 or fstat(fd, &info) != 0 or not S_ISREG(info.st_mode)) {
+                return false;
+            }
+
+            auto offset = ftello(stream);
+            if (offset < 0) {
+                return false;
+            }
+
+            auto size = static_cast<std::size_t>(info.st_size);
+            if (size != 0) {
+                auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data == MAP_FAILED) {
+                    return false;
+                }
+                madvise(data, size, MADV_SEQUENTIAL);
+                m_data = static_cast<char*>(data);
+            }
+
+            m_size  = size;
+            m_pos   = std::min(static_cast<std::size_t>(offset), size);
+            m_error = false;
+
+            return true;
+        }
+
+        void unmap() noexcept
+        {
+            if (m_data) {
+                munmap(m_data, m_size);
+            }
+            m_data = nullptr;
+            m_size = 0;
+            m_pos  = 0;
+        }
+
+        char*         m_data   = nullptr;
+        std::size_t   m_size   = 0;
+        std::size_t   m_pos    = 0;
+        std::uint64_t m_maps   = 0;
+        bool          m_mapped = false;    // a stream was mapped, or failed to be, since the last reset
+        bool          m_error  = false;
+    };
+    static_assert(LineReader<MappedReader>);
+#endif
+
 #if defined(__GLIBC__) and defined(LINR_ENABLE_GETLINE)
     using Reader    = GetlineReader;
     using BufReader = BufGetlineReader;
@@ -0,0 +1,324 @@
+#ifndef LINR_DETAIL_PARSE_FLOAT_HPP
+#define LINR_DETAIL_PARSE_FLOAT_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/parse_int.hpp"
+#include "linr/detail/pow5_table.hpp"
+
+#include <bit>
+#include <cfloat>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace linr::detail
+{
+    /**
+     * @brief Floating point types that can take the fast path (IEEE 754 binary32/binary64 without excess
+     * intermediate precision).
+     */
+    template <typename T>
+    concept FastFloat = (std::same_as<T, float> or std::same_as<T, double>)    //
+                    and std::numeric_limits<T>::is_iec559                   //
+                    and std::endian::native == std::endian::little          //
+                    and FLT_EVAL_METHOD == 0;
+
+    template <typename T>
+    struct FloatTraits;
+
+    template <>
+    struct FloatTraits<float>
+    {
+        using Bits = std::uint32_t;
+
+        static constexpr int mantissa_bits          = 23;
+        static constexpr int minimum_exponent       = -127;
+        static constexpr int infinite_power         = 0xFF;
+        static constexpr int sign_shift             = 31;
+        static constexpr int smallest_power_of_ten  = -65;
+        static constexpr int largest_power_of_ten   = 38;
+        static constexpr int min_round_to_even      = -17;
+        static constexpr int max_round_to_even      = 10;
+        static constexpr int max_exponent_fast_path = 10;
+
+        static constexpr std::uint64_t max_mantissa_fast_path = std::uint64_t{ 2 } << mantissa_bits;
+
+        static constexpr float exact_powers_of_ten[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f,  1e5f,
+                                                         1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+    };
+
+    template <>
+    struct FloatTraits<double>
+    {
+        using Bits = std::uint64_t;
+
+        static constexpr int mantissa_bits          = 52;
+        static constexpr int minimum_exponent       = -1023;
+        static constexpr int infinite_power         = 0x7FF;
+        static constexpr int sign_shift             = 63;
+        static constexpr int smallest_power_of_ten  = Pow5Table::smallest_power;
+        static constexpr int largest_power_of_ten   = Pow5Table::largest_power;
+        static constexpr int min_round_to_even      = -4;
+        static constexpr int max_round_to_even      = 23;
+        static constexpr int max_exponent_fast_path = 22;
+
+        static constexpr std::uint64_t max_mantissa_fast_path = std::uint64_t{ 2 } << mantissa_bits;
+
+        static constexpr double exact_powers_of_ten[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                          1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                          1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    };
+
+    struct U128
+    {
+        std::uint64_t m_high;
+        std::uint64_t m_low;
+    };
+
+    inline U128 full_multiplication(std::uint64_t a, std::uint64_t b) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        __extension__ using Wide = unsigned __int128;
+
+        auto product = static_cast<Wide>(a) * b;
+        return { static_cast<std::uint64_t>(product >> 64), static_cast<std::uint64_t>(product) };
+#else
+        auto a_lo = a & 0xFFFF'FFFF;
+        auto a_hi = a >> 32;
+        auto b_lo = b & 0xFFFF'FFFF;
+        auto b_hi = b >> 32;
+
+        auto lo_lo = a_lo * b_lo;
+        auto hi_lo = a_hi * b_lo;
+        auto lo_hi = a_lo * b_hi;
+        auto hi_hi = a_hi * b_hi;
+
+        auto cross = (lo_lo >> 32) + (hi_lo & 0xFFFF'FFFF) + lo_hi;
+        auto high  = hi_hi + (hi_lo >> 32) + (cross >> 32);
+        auto low   = (cross << 32) | (lo_lo & 0xFFFF'FFFF);
+
+        return { high, low };
+#endif
+    }
+
+    /**
+     * @brief A decimal number `mantissa * 10^exponent` as read from the input.
+     */
+    struct Decimal
+    {
+        std::uint64_t m_mantissa;
+        std::int64_t  m_exponent;
+        bool          m_negative;
+    };
+
+    /**
+     * @brief Read a plain decimal number (`-123.456e-7` shape) with at most 19 significant digits.
+     *
+     * @return The decimal, or nothing if the input has another shape (inf, nan, invalid, too many digits).
+     */
+    inline Opt<Decimal> scan_decimal(Str str) noexcept
+    {
+        const auto* ptr  = str.data();
+        const auto* last = str.data() + str.size();
+
+        auto is_digit = [](char c) { return static_cast<unsigned char>(c - '0') <= 9; };
+
+        auto negative = ptr != last and *ptr == '-';
+        if (negative) {
+            ++ptr;
+        }
+
+        const auto* start    = ptr;
+        auto        mantissa = std::uint64_t{ 0 };
+
+        for (; ptr != last and is_digit(*ptr); ++ptr) {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(*ptr - '0');
+        }
+
+        auto digits   = ptr - start;
+        auto exponent = std::int64_t{ 0 };
+
+        if (ptr != last and *ptr == '.') {
+            const auto* fraction = ++ptr;
+
+            while (last - ptr >= 8) {
+                auto word = std::uint64_t{};
+                std::memcpy(&word, ptr, sizeof(word));
+                if (not is_eight_digits(word)) {
+                    break;
+                }
+                mantissa  = mantissa * 100'000'000 + parse_eight_digits(word);
+                ptr      += 8;
+            }
+            for (; ptr != last and is_digit(*ptr); ++ptr) {
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(*ptr - '0');
+            }
+
+            exponent  = fraction - ptr;
+            digits   += ptr - fraction;
+        }
+
+        if (digits == 0) {
+            return std::nullopt;
+        }
+
+        const auto* digits_end = ptr;
+
+        if (ptr != last and (*ptr == 'e' or *ptr == 'E')) {
+            ++ptr;
+
+            auto exp_negative = ptr != last and *ptr == '-';
+            if (ptr != last and (*ptr == '-' or *ptr == '+')) {
+                ++ptr;
+            }
+
+            // a dangling exponent marker is not part of the number
+            if (ptr != last and is_digit(*ptr)) {
+                auto exp_number = std::int64_t{ 0 };
+                for (; ptr != last and is_digit(*ptr); ++ptr) {
+                    if (exp_number < 0x1000'0000) {
+                        exp_number = exp_number * 10 + (*ptr - '0');
+                    }
+                }
+                exponent += exp_negative ? -exp_number : exp_number;
+            }
+        }
+
+        // the mantissa may have wrapped around, leading zeros are not significant though
+        if (digits > 19) {
+            for (const auto* p = start; p != digits_end and (*p == '0' or *p == '.'); ++p) {
+                digits -= *p == '0' ? 1 : 0;
+            }
+            if (digits > 19) {
+                return std::nullopt;
+            }
+        }
+
+        return Decimal{ mantissa, exponent, negative };
+    }
+
+    /**
+     * @brief Convert a decimal into the nearest binary floating point using Clinger's fast path or the
+     * Eisel-Lemire algorithm.
+     *
+     * @return The value, or nothing if the result is not a normal number or the rounding can't be decided.
+     */
+    template <FastFloat T>
+    Opt<T> decimal_to_float(Decimal decimal) noexcept
+    {
+        using Traits = FloatTraits<T>;
+        using Bits   = typename Traits::Bits;
+
+        auto w = decimal.m_mantissa;
+        auto q = decimal.m_exponent;
+
+        if (w == 0) {
+            return decimal.m_negative ? -T{ 0 } : T{ 0 };
+        }
+
+        // Clinger's fast path: both the mantissa and the power of ten are exact, one rounding only
+        if (w <= Traits::max_mantissa_fast_path and q >= -Traits::max_exponent_fast_path
+            and q <= Traits::max_exponent_fast_path) {
+            auto value = static_cast<T>(w);
+            if (q < 0) {
+                value /= Traits::exact_powers_of_ten[-q];
+            } else {
+                value *= Traits::exact_powers_of_ten[q];
+            }
+            return decimal.m_negative ? -value : value;
+        }
+
+        // out of range or subnormal results are left to the exact fallback
+        if (q < Traits::smallest_power_of_ten or q > Traits::largest_power_of_ten) {
+            return std::nullopt;
+        }
+
+        auto leading_zeros = std::countl_zero(w);
+        w <<= leading_zeros;
+
+        // compute w * 5^q with enough precision to get the mantissa bits plus the rounding bits
+        auto index   = static_cast<std::size_t>(2 * (q - Pow5Table::smallest_power));
+        auto product = full_multiplication(w, Pow5Table::values[index]);
+
+        constexpr auto precision_mask = std::uint64_t{ 0xFFFF'FFFF'FFFF'FFFF } >> (Traits::mantissa_bits + 3);
+        if ((product.m_high & precision_mask) == precision_mask) {
+            auto second     = full_multiplication(w, Pow5Table::values[index + 1]);
+            product.m_low  += second.m_high;
+            product.m_high += second.m_high > product.m_low ? 1 : 0;
+        }
+
+        if (product.m_low == 0xFFFF'FFFF'FFFF'FFFF and (q < -27 or q > 55)) {
+            return std::nullopt;
+        }
+
+        auto upper_bit = static_cast<int>(product.m_high >> 63);
+        auto shift     = upper_bit + 64 - Traits::mantissa_bits - 3;
+        auto mantissa  = product.m_high >> shift;
+
+        // floor(log2(10^q)) + 63, valid for the exponent range of the table
+        auto power = static_cast<std::int64_t>((((152'170 + 65'536) * q) >> 16) + 63);
+        auto power2 = power + upper_bit - leading_zeros - Traits::minimum_exponent;
+
+        if (power2 <= 0) {
+            return std::nullopt;
+        }
+
+        // exactly halfway between two floats: round to even
+        if (product.m_low <= 1 and q >= Traits::min_round_to_even and q <= Traits::max_round_to_even
+            and (mantissa & 3) == 1 and (mantissa << shift) == product.m_high) {
+            mantissa &= ~std::uint64_t{ 1 };
+        }
+
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+
+        if (mantissa >= (std::uint64_t{ 2 } << Traits::mantissa_bits)) {
+            mantissa = std::uint64_t{ 1 } << Traits::mantissa_bits;
+            ++power2;
+        }
+        mantissa &= ~(std::uint64_t{ 1 } << Traits::mantissa_bits);
+
+        if (power2 >= Traits::infinite_power) {
+            return std::nullopt;
+        }
+
+        auto bits = static_cast<Bits>(mantissa)
+                  | static_cast<Bits>(static_cast<Bits>(power2) << Traits::mantissa_bits)
+                  | static_cast<Bits>(static_cast<Bits>(decimal.m_negative) << Traits::sign_shift);
+
+        return std::bit_cast<T>(bits);
+    }
+
+    /**
+     * @brief Parse a floating point number, bit-identical to `std::from_chars` in general format.
+     *
+     * Plain decimal numbers are converted on a fast path. Anything else (inf, nan, more than 19 significant
+     * digits, results that are subnormal or out of range, or ambiguous rounding) goes to `std::from_chars`.
+     *
+     * @param str The string to parse.
+     */
+    template <FastFloat T>
+    Result<T> parse_float(Str str) noexcept
+    {
+        if (auto decimal = scan_decimal(str); decimal.has_value()) {
+            if (auto value = decimal_to_float<T>(*decimal); value.has_value()) {
+                return *value;
+            }
+        }
+
+        T value;
+        auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+
+        if (ec == std::errc::invalid_argument) {
+            return make_error<T>(Error::InvalidInput);
+        } else if (ec == std::errc::result_out_of_range) {
+            return make_error<T>(Error::OutOfRange);
+        }
+
+        return value;
+    }
+}
+
+#endif /* end of include guard: LINR_DETAIL_PARSE_FLOAT_HPP */
@@ -0,0 +1,133 @@
+#ifndef LINR_DETAIL_PARSE_INT_HPP
+#define LINR_DETAIL_PARSE_INT_HPP
+
+#include "linr/common.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace linr::detail
+{
+    /**
+     * @brief Integer types that `std::from_chars` accepts (character types other than the signed and
+     * unsigned `char` are excluded, as is `bool`).
+     */
+    template <typename T>
+    concept Integer = std::same_as<T, signed char> or std::same_as<T, unsigned char>
+                   or std::same_as<T, short> or std::same_as<T, unsigned short>    //
+                   or std::same_as<T, int> or std::same_as<T, unsigned int>        //
+                   or std::same_as<T, long> or std::same_as<T, unsigned long>      //
+                   or std::same_as<T, long long> or std::same_as<T, unsigned long long>;
+
+    /**
+     * @brief Check whether all 8 bytes packed in a little-endian word are ASCII digits.
+     */
+    constexpr bool is_eight_digits(std::uint64_t word) noexcept
+    {
+        // a byte is a digit when its high nibble is 3, and still 3 once 6 is added (no carry past '9')
+        auto high     = word & 0xF0F0'F0F0'F0F0'F0F0;
+        auto overflow = ((word + 0x0606'0606'0606'0606) & 0xF0F0'F0F0'F0F0'F0F0) >> 4;
+        return (high | overflow) == 0x3333'3333'3333'3333;
+    }
+
+    /**
+     * @brief Convert 8 ASCII digits packed in a little-endian word into their value using SWAR.
+     */
+    constexpr std::uint32_t parse_eight_digits(std::uint64_t word) noexcept
+    {
+        constexpr auto mask = std::uint64_t{ 0x0000'00FF'0000'00FF };
+        constexpr auto mul1 = std::uint64_t{ 100 } + (std::uint64_t{ 1'000'000 } << 32);
+        constexpr auto mul2 = std::uint64_t{ 1 } + (std::uint64_t{ 10'000 } << 32);
+
+        word -= 0x3030'3030'3030'3030;
+        word  = (word * 10) + (word >> 8);
+        word  = (((word & mask) * mul1) + (((word >> 16) & mask) * mul2)) >> 32;
+
+        return static_cast<std::uint32_t>(word);
+    }
+
+    /**
+     * @brief Parse a base 10 integer with the same semantics as `std::from_chars`.
+     *
+     * An optional `-` (signed types only) followed by at least one digit, parsing stops at the first
+     * non-digit. Eight digits are consumed at a time using SWAR while available. The digits are accumulated
+     * into 64 bits then checked against the range of `T`, so overflow is detected exactly.
+     *
+     * @param str The string to parse.
+     * @return The parsed value, `Error::InvalidInput` if there is no digit, or `Error::OutOfRange` if the
+     * value doesn't fit in `T`.
+     */
+    template <Integer T>
+    Result<T> parse_integer(Str str) noexcept
+    {
+        using U = std::make_unsigned_t<T>;
+
+        const auto* ptr  = str.data();
+        const auto* last = str.data() + str.size();
+
+        auto negative = false;
+        if constexpr (std::is_signed_v<T>) {
+            if (ptr != last and *ptr == '-') {
+                negative = true;
+                ++ptr;
+            }
+        }
+
+        // largest magnitude representable given the sign
+        const auto limit = static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1u : 0u);
+
+        const auto* first = ptr;
+        auto        acc   = std::uint64_t{ 0 };
+
+        // leading zeros don't count toward the number of significant digits
+        while (ptr != last and *ptr == '0') {
+            ++ptr;
+        }
+
+        // up to 19 significant digits always fit in 64 bits, only the 20th needs an overflow check
+        const auto* significant = ptr;
+
+        if constexpr (std::endian::native == std::endian::little) {
+            while (last - ptr >= 8 and ptr - significant <= 11) {
+                auto word = std::uint64_t{};
+                std::memcpy(&word, ptr, sizeof(word));
+                if (not is_eight_digits(word)) {
+                    break;
+                }
+
+                acc  = acc * 100'000'000 + parse_eight_digits(word);
+                ptr += 8;
+            }
+        }
+
+        for (; ptr != last; ++ptr) {
+            auto digit = static_cast<unsigned char>(*ptr - '0');
+            if (digit > 9) {
+                break;
+            }
+
+            if (auto count = ptr - significant; count >= 19) {
+                constexpr auto max = std::numeric_limits<std::uint64_t>::max();
+                if (count > 19 or acc > (max - digit) / 10) {
+                    return make_error<T>(Error::OutOfRange);
+                }
+            }
+            acc = acc * 10 + digit;
+        }
+
+        if (ptr == first) {
+            return make_error<T>(Error::InvalidInput);
+        } else if (acc > limit) {
+            return make_error<T>(Error::OutOfRange);
+        }
+
+        auto magnitude = static_cast<U>(acc);
+        return static_cast<T>(negative ? static_cast<U>(0u - magnitude) : magnitude);
+    }
+}
+
+#endif /* end of include guard: LINR_DETAIL_PARSE_INT_HPP */
@@ -0,0 +1,132 @@
+#ifndef LINR_DETAIL_PROBE_HPP
+#define LINR_DETAIL_PROBE_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/line_reader.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace linr
+{
+    /**
+     * @brief Phases of a read, as reported to the statistics and the tracers.
+     */
+    enum class Phase : std::uint8_t
+    {
+        Read,     // the line reader reads a line
+        Split,    // the line is cut into fields
+        Parse,    // the fields are parsed into values
+    };
+}
+
+namespace linr::detail
+{
+    /**
+     * @brief Probe that observes nothing, every call compiles to nothing.
+     *
+     * A probe is a cheap handle (copied by value) that the read functions notify around their phases:
+     * `start()` returns a mark that is handed back to `finish()` at the end of the phase, along with the
+     * number of bytes of the line, and `fail()` is called with the error of a line that doesn't parse.
+     * `ProbeReader` also calls `line()` for every line read, with its size and whether the line buffer grew.
+     */
+    struct NoProbe
+    {
+        struct Mark
+        {
+        };
+
+        Mark start() const noexcept { return {}; }
+        void finish(Phase, Mark, std::size_t) const noexcept {}
+        void fail(Error) const noexcept {}
+        void line(std::size_t, bool) const noexcept {}
+    };
+
+    /**
+     * @brief Get the probe of a line reader, readers that don't have one get `NoProbe`.
+     */
+    template <typename R>
+    auto probe_of(R& reader) noexcept
+    {
+        if constexpr (requires { reader.probe(); }) {
+            return reader.probe();
+        } else {
+            return NoProbe{};
+        }
+    }
+
+    /**
+     * @brief Line reader that wraps another one and reports its reads to a probe.
+     *
+     * The read phase is reported around `readline`, the read functions report the split and parse phases
+     * through `probe()`. `D` derives from it and only provides `probe()` along with whatever the probe
+     * reports to (see `StatsReader` and `TraceReader`). The capabilities of the wrapped reader are forwarded.
+     */
+    template <typename R, typename D>
+    struct ProbeReader
+    {
+        using Line = typename R::Line;
+
+        template <typename... Args>
+            requires std::constructible_from<R, Args...>
+        ProbeReader(Args&&... args) noexcept(std::is_nothrow_constructible_v<R, Args...>)
+            : m_reader{ std::forward<Args>(args)... }
+        {
+        }
+
+        template <typename S>
+            requires LineReader<R, S>
+        Opt<Line> readline(S stream) noexcept
+        {
+            auto probe  = static_cast<D&>(*this).probe();
+            auto before = capacity();
+
+            auto mark  = probe.start();
+            auto line  = m_reader.readline(stream);
+            auto bytes = line ? line_view(line->view()).size() : std::size_t{ 0 };
+            probe.finish(Phase::Read, mark, bytes);
+
+            if (line) {
+                probe.line(bytes, capacity() > before);
+            }
+            return line;
+        }
+
+        bool error() const noexcept
+            requires requires (const R& r) { { r.error() } noexcept -> std::same_as<bool>; }
+        {
+            return m_reader.error();
+        }
+
+        void reset() noexcept
+            requires requires (R& r) { { r.reset() } noexcept; }
+        {
+            m_reader.reset();
+        }
+
+        std::size_t capacity() const noexcept
+        {
+            if constexpr (requires { { m_reader.capacity() } -> std::same_as<std::size_t>; }) {
+                return m_reader.capacity();
+            } else {
+                return 0;
+            }
+        }
+
+        std::uint64_t refills() const noexcept
+        {
+            if constexpr (requires { { m_reader.refills() } -> std::same_as<std::uint64_t>; }) {
+                return m_reader.refills();
+            } else {
+                return 0;
+            }
+        }
+
+        R m_reader;
+    };
+}
+
+#endif /* end of include guard: LINR_DETAIL_PROBE_HPP */
@@ -3,15 +3,112 @@
 
 #include "linr/common.hpp"
 #include "linr/detail/line_reader.hpp"
+#include "linr/detail/probe.hpp"
 #include "linr/parser.hpp"
 
+#include <type_traits>
+#include <vector>
+
 namespace linr::detail
 {
-    template <Parseable... Ts, LineReader R>
+    template <typename T>
+    struct VectorTraits : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct VectorTraits<std::vector<T>> : std::true_type
+    {
+        using Value = T;
+    };
+
+    /**
+     * @brief A `std::vector` of parseable values, read from a line with any number of values.
+     */
+    template <typename V>
+    concept ParseableVector = VectorTraits<V>::value and Parseable<typename VectorTraits<V>::Value>
+                          and std::movable<typename VectorTraits<V>::Value>;
+
+    /**
+     * @brief Split a line, then parse the parts, reporting both phases to the probe.
+     */
+    template <typename T, typename P, typename SplitFn, typename ParseFn>
+    Result<T> split_and_parse(Str line, P probe, SplitFn&& split_fn, ParseFn&& parse_fn) noexcept
+    {
+        auto mark  = probe.start();
+        auto parts = split_fn();
+        probe.finish(Phase::Split, mark, line.size());
+
+        if (not parts) {
+            probe.fail(Error::InvalidInput);
+            return make_error<T>(Error::InvalidInput);
+        }
+
+        mark        = probe.start();
+        auto result = parse_fn(*parts);
+        probe.finish(Phase::Parse, mark, line.size());
+
+        if (not result) {
+            probe.fail(result.error());
+        }
+        return result;
+    }
+
+    /**
+     * @brief Split a line and parse the parts into a tuple.
+     */
+    template <Parseable... Ts, typename P = NoProbe>
         requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
-    Results<Ts...> read_impl(std::FILE* stream, R& reader, Opt<Str> prompt, char delim) noexcept
+    Results<Ts...> parse_line(Str line, char delim, const ParseContext& context, P probe = {}) noexcept
     {
-        if (std::ferror(stream)) {
+        return split_and_parse<Tup<Ts...>>(
+            line,
+            probe,
+            [&] { return util::split<sizeof...(Ts)>(line, delim); },
+            [&](auto& parts) { return parse_into_tuple<Ts...>(parts, context); }
+        );
+    }
+
+    /**
+     * @brief Split a line and parse the parts into an array.
+     */
+    template <Parseable T, std::size_t N, typename P = NoProbe>
+        requires (std::movable<T> and N > 0)
+    AResults<T, N> parse_line(Str line, char delim, const ParseContext& context, P probe = {}) noexcept
+    {
+        return split_and_parse<Arr<T, N>>(
+            line,
+            probe,
+            [&] { return util::split<N>(line, delim); },
+            [&](auto& parts) { return parse_array<T, N>(parts, context); }
+        );
+    }
+
+    /**
+     * @brief Split a line and parse the parts into the fields of an aggregate.
+     */
+    template <ParseableAggregate T, typename P = NoProbe>
+    Result<T> parse_line(Str line, char delim, const ParseContext& context, P probe = {}) noexcept
+    {
+        return split_and_parse<T>(
+            line,
+            probe,
+            [&] { return util::split<field_count<T>()>(line, delim); },
+            [&](auto& parts) { return parse_into_aggregate<T>(parts, context); }
+        );
+    }
+
+    template <Parseable... Ts, typename S, LineReader<S> R>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    Results<Ts...> read_impl(
+        S                   stream,
+        R&                  reader,
+        Opt<Str>            prompt,
+        char                delim,
+        const ParseContext& context = {}
+    ) noexcept
+    {
+        if (stream_error(stream, reader)) {
             return make_error<Tup<Ts...>>(Error::Unknown);
         }
 
@@ -21,21 +118,24 @@ namespace linr::detail
 
         auto line = reader.readline(stream);
         if (not line) {
-            return make_error<Tup<Ts...>>(Error::EndOfFile);
+            auto error = stream_error(stream, reader) ? Error::Unknown : Error::EndOfFile;
+            return make_error<Tup<Ts...>>(error);
         }
 
-        auto parts = util::split<sizeof...(Ts)>(line->view(), delim);
-        if (parts) {
-            return parse_into_tuple<Ts...>(*parts);
-        }
-        return make_error<Tup<Ts...>>(Error::InvalidInput);
+        return parse_line<Ts...>(line->view(), delim, context, probe_of(reader));
     }
 
-    template <Parseable T, std::size_t N, LineReader R>
+    template <Parseable T, std::size_t N, typename S, LineReader<S> R>
         requires (std::movable<T> and N > 0)
-    AResults<T, N> read_impl(std::FILE* stream, R& reader, Opt<Str> prompt, char delim) noexcept
+    AResults<T, N> read_impl(
+        S                   stream,
+        R&                  reader,
+        Opt<Str>            prompt,
+        char                delim,
+        const ParseContext& context = {}
+    ) noexcept
     {
-        if (std::ferror(stream)) {
+        if (stream_error(stream, reader)) {
             return make_error<Arr<T, N>>(Error::Unknown);
         }
 
@@ -45,14 +145,241 @@ namespace linr::detail
 
         auto line = reader.readline(stream);
         if (not line) {
-            return make_error<Arr<T, N>>(Error::EndOfFile);
+            auto error = stream_error(stream, reader) ? Error::Unknown : Error::EndOfFile;
+            return make_error<Arr<T, N>>(error);
+        }
+
+        return parse_line<T, N>(line->view(), delim, context, probe_of(reader));
+    }
+
+    template <ParseableAggregate T, typename S, LineReader<S> R>
+    Result<T> read_impl(
+        S                   stream,
+        R&                  reader,
+        Opt<Str>            prompt,
+        char                delim,
+        const ParseContext& context = {}
+    ) noexcept
+    {
+        if (stream_error(stream, reader)) {
+            return make_error<T>(Error::Unknown);
+        }
+
+        if (prompt) {
+            std::fwrite(prompt->data(), sizeof(Str::value_type), prompt->size(), stdout);
+        }
+
+        auto line = reader.readline(stream);
+        if (not line) {
+            auto error = stream_error(stream, reader) ? Error::Unknown : Error::EndOfFile;
+            return make_error<T>(error);
+        }
+
+        return parse_line<T>(line->view(), delim, context, probe_of(reader));
+    }
+
+    /**
+     * @brief Read up to `max_lines` lines, handing each line to `on_line` until it returns an error.
+     *
+     * The stream is checked for error once up front instead of once per line; there is no prompt.
+     */
+    template <typename S, LineReader<S> R, typename Fn>
+    BatchResult read_lines_impl(S stream, R& reader, std::size_t max_lines, Fn&& on_line) noexcept
+    {
+        if (stream_error(stream, reader)) {
+            return { 0, Error::Unknown };
+        }
+
+        auto count = std::size_t{ 0 };
+        while (count < max_lines) {
+            auto line = reader.readline(stream);
+            if (not line) {
+                auto error = stream_error(stream, reader) ? Error::Unknown : Error::EndOfFile;
+                return { count, error };
+            }
+
+            if (auto error = on_line(line->view()); error.has_value()) {
+                return { count, error };
+            }
+            ++count;
+        }
+
+        return { count, std::nullopt };
+    }
+
+    template <Parseable... Ts, typename S, LineReader<S> R>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    BatchResult read_batch_impl(
+        S                        stream,
+        R&                       reader,
+        std::size_t              max_lines,
+        std::vector<Tup<Ts...>>& out,
+        char                     delim,
+        const ParseContext&      context
+    ) noexcept
+    {
+        auto probe = probe_of(reader);
+        return read_lines_impl(stream, reader, max_lines, [&](Str line) -> Opt<Error> {
+            auto row = parse_line<Ts...>(line, delim, context, probe);
+            if (not row) {
+                return row.error();
+            }
+
+            try {
+                out.push_back(std::move(row).value());
+            } catch (...) {
+                return Error::Unknown;
+            }
+            return std::nullopt;
+        });
+    }
+
+    template <Parseable T, std::size_t N, typename S, LineReader<S> R>
+        requires (std::movable<T> and N > 0)
+    BatchResult read_batch_impl(
+        S                       stream,
+        R&                      reader,
+        std::size_t             max_lines,
+        std::vector<Arr<T, N>>& out,
+        char                    delim,
+        const ParseContext&     context
+    ) noexcept
+    {
+        auto probe = probe_of(reader);
+        return read_lines_impl(stream, reader, max_lines, [&](Str line) -> Opt<Error> {
+            auto row = parse_line<T, N>(line, delim, context, probe);
+            if (not row) {
+                return row.error();
+            }
+
+            try {
+                out.push_back(std::move(row).value());
+            } catch (...) {
+                return Error::Unknown;
+            }
+            return std::nullopt;
+        });
+    }
+
+    template <Parseable... Ts, typename S, LineReader<S> R>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    BatchResult read_columns_impl(
+        S                   stream,
+        R&                  reader,
+        std::size_t         max_rows,
+        Columns<Ts...>&     columns,
+        char                delim,
+        const ParseContext& context
+    ) noexcept
+    {
+        auto probe = probe_of(reader);
+        return read_lines_impl(stream, reader, max_rows, [&](Str line) -> Opt<Error> {
+            auto mark  = probe.start();
+            auto parts = util::split<sizeof...(Ts)>(line, delim);
+            probe.finish(Phase::Split, mark, line.size());
+
+            if (not parts) {
+                probe.fail(Error::InvalidInput);
+                return Error::InvalidInput;
+            }
+
+            auto error  = Opt<Error>{};
+            auto failed = sizeof...(Ts);
+
+            // each field is appended to its column as soon as it's parsed, stopping at the first failure
+            const auto parse_field = [&]<std::size_t I>() {
+                using T = std::tuple_element_t<I, Tup<Ts...>>;
+
+                auto result = parse<T>((*parts)[I], context);
+                if (not result) {
+                    error  = result.error();
+                    failed = I;
+                    return false;
+                }
+
+                try {
+                    std::get<I>(columns).push_back(std::move(result).value());
+                } catch (...) {
+                    error  = Error::Unknown;
+                    failed = I;
+                    return false;
+                }
+                return true;
+            };
+            const auto parse_row = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return (parse_field.template operator()<Is>() and ...);
+            };
+
+            mark        = probe.start();
+            auto parsed = parse_row(std::index_sequence_for<Ts...>{});
+            probe.finish(Phase::Parse, mark, line.size());
+
+            if (not parsed) {
+                probe.fail(*error);
+
+                // drop the fields of the partial row so the columns stay the same length
+                util::for_each_tuple(columns, [&]<std::size_t I, typename C>(C& column) {
+                    if (I < failed) {
+                        column.pop_back();
+                    }
+                });
+            }
+
+            return error;
+        });
+    }
+
+    template <Parseable T, typename S, LineReader<S> R>
+        requires std::movable<T>
+    Opt<Error> read_into_impl(
+        S                   stream,
+        R&                  reader,
+        Opt<Str>            prompt,
+        std::vector<T>&     out,
+        char                delim,
+        const ParseContext& context = {}
+    ) noexcept
+    {
+        out.clear();
+
+        if (stream_error(stream, reader)) {
+            return Error::Unknown;
+        }
+
+        if (prompt) {
+            std::fwrite(prompt->data(), sizeof(Str::value_type), prompt->size(), stdout);
+        }
+
+        auto line = reader.readline(stream);
+        if (not line) {
+            return stream_error(stream, reader) ? Error::Unknown : Error::EndOfFile;
         }
 
-        auto parts = util::split<N>(line->view(), delim);
-        if (parts) {
-            return parse_array<T, N>(*parts);
+        // the tokens are parsed as they are found, the whole line counts as the parse phase
+        auto probe = probe_of(reader);
+        auto mark  = probe.start();
+        auto error = Opt<Error>{};
+        for_each_token(line->view(), delim, [&](Str token) {
+            auto value = parse<T>(token, context);
+            if (not value) {
+                error = value.error();
+                return false;
+            }
+
+            try {
+                out.push_back(std::move(value).value());
+            } catch (...) {
+                error = Error::Unknown;
+                return false;
+            }
+            return true;
+        });
+        probe.finish(Phase::Parse, mark, line->view().size());
+
+        if (error) {
+            probe.fail(*error);
         }
-        return make_error<Arr<T, N>>(Error::InvalidInput);
+        return error;
     }
 }
 
@@ -0,0 +1,289 @@
+#ifndef LINR_DETAIL_READ_AHEAD_HPP
+#define LINR_DETAIL_READ_AHEAD_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/line_reader.hpp"
+#include "linr/detail/simd.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace linr
+{
+    /**
+     * @brief Options of the read-ahead mode.
+     */
+    struct ReadAhead
+    {
+        std::size_t buffers = 4;    // number of buffers in the ring, at least 2
+    };
+}
+
+namespace linr::detail
+{
+    /**
+     * @brief Line reader that reads the stream on a background thread.
+     *
+     * A producer thread fills a ring of buffers while the calling thread splits the buffers into lines, the
+     * buffers are handed over through a lock-free single-producer single-consumer queue. The lines are views
+     * into the current buffer, or into an internal string for a line that spans two buffers, valid until the
+     * next `readline` call.
+     *
+     * On POSIX the producer calls `read(2)` on the descriptor of the stream and hands over whatever a single
+     * call returns, so a line is available as soon as it's written to a pipe or a terminal. Elsewhere it
+     * falls back to `std::fread`, which only returns once the buffer is full or the stream ends.
+     *
+     * The producer is started on the first `readline` call and stays bound to that stream until `reset()`,
+     * which stops it (`BasicBufReader::set_stream` calls it). Nothing else may read from the stream while
+     * the producer runs. Stopping the producer, on reset or destruction, waits for its pending read.
+     */
+    struct ReadAheadReader
+    {
+        struct Line
+        {
+            Line(const char* ptr, std::size_t size)
+                : m_str{ ptr, size }
+            {
+            }
+            Str view() const noexcept { return m_str; }
+            Str m_str;
+        };
+
+        struct Buffer
+        {
+            std::vector<char> m_data;
+            std::size_t       m_size  = 0;
+            bool              m_eof   = false;
+            bool              m_error = false;
+        };
+
+        ReadAheadReader(std::size_t size, ReadAhead options)
+            : m_ring(std::max(options.buffers, std::size_t{ 2 }))
+        {
+            for (auto& buffer : m_ring) {
+                buffer.m_data.resize(std::max(size, std::size_t{ 2 }));
+            }
+        }
+
+        ~ReadAheadReader() { stop(); }
+
+        ReadAheadReader(ReadAheadReader&&)            = delete;
+        ReadAheadReader& operator=(ReadAheadReader&&) = delete;
+
+        ReadAheadReader(const ReadAheadReader&)            = delete;
+        ReadAheadReader& operator=(const ReadAheadReader&) = delete;
+
+        Opt<Line> readline(std::FILE* stream) noexcept
+        {
+            if (not m_started and not start(stream)) {
+                return {};
+            }
+
+            m_carry.clear();
+            auto carrying = false;
+
+            while (not m_done) {
+                auto*       buffer = acquire();
+                const auto* data   = buffer->m_data.data();
+                const auto* first  = data + m_pos;
+                const auto* last   = data + buffer->m_size;
+                const auto* nl     = simd::find_newline(first, last);
+
+                if (nl != last) {
+                    m_pos = static_cast<std::size_t>(nl - data) + 1;
+                    if (carrying) {
+                        if (not carry(first, nl)) {
+                            return {};
+                        }
+                        return Opt<Line>{ std::in_place, m_carry.data(), m_carry.size() };
+                    }
+                    return Opt<Line>{ std::in_place, first, static_cast<std::size_t>(nl - first) };
+                }
+
+                // the line continues in the next buffer (or ends with the stream)
+                if (not carry(first, last)) {
+                    return {};
+                }
+                carrying = carrying or first != last;
+
+                if (buffer->m_eof or buffer->m_error) {
+                    m_done  = true;
+                    m_error = buffer->m_error;
+                    break;
+                }
+                release();
+            }
+
+            // last line without trailing newline
+            if (carrying and not m_error) {
+                return Opt<Line>{ std::in_place, m_carry.data(), m_carry.size() };
+            }
+            return {};
+        }
+
+        bool error() const noexcept { return m_error; }
+
+        // stop the producer and drop the buffered data, the next `readline` starts a producer on its stream
+        void reset() noexcept
+        {
+            stop();
+
+            m_head.store(0, std::memory_order_relaxed);
+            m_tail.store(0, std::memory_order_relaxed);
+            m_stop.store(false, std::memory_order_relaxed);
+
+            m_carry.clear();
+            m_pos     = 0;
+            m_started = false;
+            m_done    = false;
+            m_error   = false;
+        }
+
+        std::size_t capacity() const noexcept { return m_ring.size() * m_ring.front().m_data.size(); }
+
+        // number of buffers handed over by the producer
+        std::uint64_t refills() const noexcept { return m_refills; }
+
+        bool start(std::FILE* stream) noexcept
+        {
+            m_started = true;
+
+#if defined(LINR_POSIX)
+            // the producer reads the descriptor, which stdio may have read past, move it to the position of
+            // the stream (a pipe has none, what stdio buffered from it is lost)
+            if (auto offset = ftello(stream); offset >= 0) {
+                lseek(fileno(stream), offset, SEEK_SET);
+            }
+#endif
+
+            try {
+                m_producer = std::thread{ [this, stream] { produce(stream); } };
+            } catch (...) {
+                m_done  = true;
+                m_error = true;
+                return false;
+            }
+            return true;
+        }
+
+        // append to the line that spans buffers, failing the reader if the string can't grow
+        bool carry(const char* first, const char* last) noexcept
+        {
+            try {
+                m_carry.append(first, last);
+            } catch (...) {
+                m_done  = true;
+                m_error = true;
+                return false;
+            }
+            return true;
+        }
+
+        void stop() noexcept
+        {
+            if (m_producer.joinable()) {
+                // hand every buffer back so a producer waiting for room wakes up and sees the stop flag
+                m_stop.store(true, std::memory_order_relaxed);
+                m_head.fetch_add(m_ring.size(), std::memory_order_release);
+                m_head.notify_one();
+                m_producer.join();
+            }
+        }
+
+        // consumer side: wait for the buffer at the head of the queue
+        Buffer* acquire() noexcept
+        {
+            auto head = m_head.load(std::memory_order_relaxed);
+            auto tail = m_tail.load(std::memory_order_acquire);
+            while (tail == head) {
+                m_tail.wait(tail, std::memory_order_acquire);
+                tail = m_tail.load(std::memory_order_acquire);
+            }
+
+            // a buffer is only acquired at its start once, `m_pos` is past a newline afterwards
+            if (m_pos == 0) {
+                ++m_refills;
+            }
+            return &m_ring[head % m_ring.size()];
+        }
+
+        // consumer side: give the buffer at the head of the queue back to the producer
+        void release() noexcept
+        {
+            m_pos = 0;
+            m_head.fetch_add(1, std::memory_order_release);
+            m_head.notify_one();
+        }
+
+        // producer side: fill buffers until the stream ends or fails
+        void produce(std::FILE* stream) noexcept
+        {
+            auto tail = m_tail.load(std::memory_order_relaxed);
+
+            while (true) {
+                auto head = m_head.load(std::memory_order_acquire);
+                while (tail - head == m_ring.size()) {
+                    m_head.wait(head, std::memory_order_acquire);
+                    head = m_head.load(std::memory_order_acquire);
+                }
+                if (m_stop.load(std::memory_order_relaxed)) {
+                    return;
+                }
+
+                auto& buffer = m_ring[tail % m_ring.size()];
+                fill(buffer, stream);
+
+                m_tail.store(++tail, std::memory_order_release);
+                m_tail.notify_one();
+
+                if (buffer.m_eof or buffer.m_error) {
+                    return;
+                }
+            }
+        }
+
+        // producer side: read once into the buffer
+        static void fill(Buffer& buffer, std::FILE* stream) noexcept
+        {
+#if defined(LINR_POSIX)
+            auto fd    = fileno(stream);
+            auto nread = ssize_t{ -1 };
+            if (fd >= 0) {
+                do {
+                    nread = ::read(fd, buffer.m_data.data(), buffer.m_data.size());
+                } while (nread < 0 and errno == EINTR);
+            }
+
+            buffer.m_size  = nread > 0 ? static_cast<std::size_t>(nread) : 0;
+            buffer.m_error = nread < 0;
+            buffer.m_eof   = nread == 0;
+#else
+            buffer.m_size  = std::fread(buffer.m_data.data(), 1, buffer.m_data.size(), stream);
+            buffer.m_error = buffer.m_size < buffer.m_data.size() and std::ferror(stream) != 0;
+            buffer.m_eof   = buffer.m_size < buffer.m_data.size() and not buffer.m_error;
+#endif
+        }
+
+        std::vector<Buffer>      m_ring;
+        std::atomic<std::size_t> m_head = 0;    // next buffer to consume, written by the consumer only
+        std::atomic<std::size_t> m_tail = 0;    // next buffer to fill, written by the producer only
+        std::atomic<bool>        m_stop = false;
+        std::thread              m_producer;
+
+        std::string   m_carry;    // line that spans buffers
+        std::size_t   m_pos     = 0;
+        std::uint64_t m_refills = 0;
+        bool          m_started = false;
+        bool          m_done    = false;
+        bool          m_error   = false;
+    };
+    static_assert(LineReader<ReadAheadReader>);
+}
+
+#endif /* end of include guard: LINR_DETAIL_READ_AHEAD_HPP */
@@ -0,0 +1,199 @@
+#ifndef LINR_DETAIL_SIMD_HPP
+#define LINR_DETAIL_SIMD_HPP
+
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) or defined(_M_X64)
+#    define LINR_SIMD_SSE2
+#    include <emmintrin.h>
+#    if defined(__GNUC__)
+#        define LINR_SIMD_AVX2
+#        include <immintrin.h>
+#    endif
+#endif
+
+namespace linr::detail::simd
+{
+    /**
+     * @brief Classification of a 64-byte block, bit `i` is set if byte `i` of the block matches.
+     */
+    struct Masks
+    {
+        std::uint64_t m_delim;
+        std::uint64_t m_null;
+        std::uint64_t m_newline;
+    };
+
+    inline constexpr std::size_t block_size = 64;
+
+    using FindFn = const char* (*)(const char*, const char*) noexcept;
+
+    /**
+     * @brief Index of the lowest set bit, the mask must not be zero.
+     */
+    template <typename T>
+        requires std::same_as<T, unsigned> or std::same_as<T, std::uint64_t>
+    int lowest_bit(T mask) noexcept
+    {
+#if defined(__GNUC__)
+        if constexpr (sizeof(T) == sizeof(unsigned)) {
+            return __builtin_ctz(mask);
+        } else {
+            return __builtin_ctzll(mask);
+        }
+#else
+        auto index = 0;
+        while ((mask & 1u) == 0) {
+            mask >>= 1;
+            ++index;
+        }
+        return index;
+#endif
+    }
+
+    // scalar
+    // ------
+
+    inline const char* find_newline_scalar(const char* first, const char* last) noexcept
+    {
+        auto* found = std::memchr(first, '\n', static_cast<std::size_t>(last - first));
+        return found != nullptr ? static_cast<const char*>(found) : last;
+    }
+
+    inline const char* find_line_end_scalar(const char* first, const char* last) noexcept
+    {
+        while (first != last and *first != '\n' and *first != '\0') {
+            ++first;
+        }
+        return first;
+    }
+
+#if defined(LINR_SIMD_SSE2)
+    // sse2
+    // ----
+
+    template <bool WithNull>
+    const char* find_sse2(const char* first, const char* last) noexcept
+    {
+        const auto newline = _mm_set1_epi8('\n');
+        const auto null    = _mm_setzero_si128();
+
+        for (; last - first >= 16; first += 16) {
+            auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            auto match = _mm_cmpeq_epi8(chunk, newline);
+            if constexpr (WithNull) {
+                match = _mm_or_si128(match, _mm_cmpeq_epi8(chunk, null));
+            }
+            if (auto mask = static_cast<unsigned>(_mm_movemask_epi8(match)); mask != 0) {
+                return first + lowest_bit(mask);
+            }
+        }
+
+        return WithNull ? find_line_end_scalar(first, last) : find_newline_scalar(first, last);
+    }
+
+    /**
+     * @brief Classify a block of `block_size` bytes into delimiter, null, and newline masks.
+     *
+     * SSE2 is part of the x86-64 baseline so this is always available there and can be inlined.
+     *
+     * @param block Pointer to the block, must have at least `block_size` readable bytes.
+     * @param delim The delimiter.
+     */
+    inline Masks classify_sse2(const char* block, char delim) noexcept
+    {
+        const auto delims  = _mm_set1_epi8(delim);
+        const auto null    = _mm_setzero_si128();
+        const auto newline = _mm_set1_epi8('\n');
+
+        auto masks = Masks{ 0, 0, 0 };
+        for (auto i = 0u; i < block_size; i += 16) {
+            auto chunk        = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+            auto delim_bits   = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, delims));
+            auto null_bits    = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, null));
+            auto newline_bits = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline));
+
+            masks.m_delim   |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(delim_bits)) << i;
+            masks.m_null    |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(null_bits)) << i;
+            masks.m_newline |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(newline_bits)) << i;
+        }
+        return masks;
+    }
+#endif
+
+#if defined(LINR_SIMD_AVX2)
+    // avx2
+    // ----
+
+    template <bool WithNull>
+    __attribute__((target("avx2"))) const char* find_avx2(const char* first, const char* last) noexcept
+    {
+        const auto newline = _mm256_set1_epi8('\n');
+        const auto null    = _mm256_setzero_si256();
+
+        for (; last - first >= 32; first += 32) {
+            auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            auto match = _mm256_cmpeq_epi8(chunk, newline);
+            if constexpr (WithNull) {
+                match = _mm256_or_si256(match, _mm256_cmpeq_epi8(chunk, null));
+            }
+            if (auto mask = static_cast<unsigned>(_mm256_movemask_epi8(match)); mask != 0) {
+                return first + lowest_bit(mask);
+            }
+        }
+
+        return find_sse2<WithNull>(first, last);
+    }
+#endif
+
+    /**
+     * @brief Pick the best implementation supported by the running CPU.
+     *
+     * @tparam WithNull Whether the null character also terminates the search.
+     */
+    template <bool WithNull>
+    FindFn select_find() noexcept
+    {
+#if defined(LINR_SIMD_AVX2)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return &find_avx2<WithNull>;
+        }
+#endif
+#if defined(LINR_SIMD_SSE2)
+        return &find_sse2<WithNull>;
+#else
+        return WithNull ? &find_line_end_scalar : &find_newline_scalar;
+#endif
+    }
+
+    /**
+     * @brief Find the first newline in a range.
+     *
+     * @param first Start of the range.
+     * @param last End of the range.
+     * @return Pointer to the newline, or `last` if there is none.
+     */
+    inline const char* find_newline(const char* first, const char* last) noexcept
+    {
+        static const auto impl = select_find<false>();
+        return impl(first, last);
+    }
+
+    /**
+     * @brief Find the first newline or null character in a range.
+     *
+     * @param first Start of the range.
+     * @param last End of the range.
+     * @return Pointer to the found character, or `last` if there is none.
+     */
+    inline const char* find_line_end(const char* first, const char* last) noexcept
+    {
+        static const auto impl = select_find<true>();
+        return impl(first, last);
+    }
+}
+
+#endif /* end of include guard: LINR_DETAIL_SIMD_HPP */
@@ -0,0 +1,225 @@
+#ifndef LINR_DETAIL_SPLIT_HPP
+#define LINR_DETAIL_SPLIT_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace linr::detail
+{
+    /**
+     * @brief Byte-at-a-time split, used in constant evaluation and where no SIMD is available.
+     *
+     * See `util::split` for the semantics.
+     */
+    template <std::size_t N>
+    constexpr Opt<Arr<Str, N>> split_scalar(Str str, char delim) noexcept
+    {
+        Arr<Str, N> res = {};
+
+        std::size_t i = 0;
+        std::size_t j = 0;
+
+        auto find_delim_or_null = [&](std::size_t start) {
+            auto iter = std::find_if(str.begin() + start, str.end(), [&](char chr) {
+                return chr == delim or chr == '\0';
+            });
+            return iter == str.end() ? Str::npos : static_cast<std::size_t>(iter - str.begin());
+        };
+
+        while (i < N and j < str.size() and str[j] != '\0' and str[j] != '\n') {
+            while (j != str.size() and str[j] == delim) {
+                ++j;
+            }
+
+            auto pos = find_delim_or_null(j);
+
+            if (pos == Str::npos) {
+                res[i++] = str.substr(j);
+                break;
+            }
+
+            if (str[pos] == '\0' or str[pos] == '\n') {
+                res[i++] = str.substr(j, pos - j);
+                break;
+            }
+
+            res[i++] = str.substr(j, pos - j);
+            j        = pos + 1;
+        }
+
+        if (i != N) {
+            return std::nullopt;
+        }
+
+        return res;
+    }
+
+    /**
+     * @brief Call `fn` on every token of a line, the number of tokens is not known in advance.
+     *
+     * Tokens are the non-empty runs of characters between delimiters (so leading, trailing, and repeated
+     * delimiters are ignored), the line ends at the first null character or newline.
+     *
+     * @param str The line.
+     * @param delim The delimiter.
+     * @param fn Function called with each token, returns `false` to stop.
+     * @return Whether every token was visited.
+     */
+    template <typename Fn>
+    bool for_each_token(Str str, char delim, Fn&& fn) noexcept
+    {
+        const auto* end = simd::find_line_end(str.data(), str.data() + str.size());
+
+        auto line = str.substr(0, static_cast<std::size_t>(end - str.data()));
+        auto pos  = std::size_t{ 0 };
+
+        while (true) {
+            while (pos != line.size() and line[pos] == delim) {
+                ++pos;
+            }
+            if (pos == line.size()) {
+                return true;
+            }
+
+            auto next = line.find(delim, pos);
+            if (not fn(line.substr(pos, next - pos))) {
+                return false;
+            }
+            if (next == Str::npos) {
+                return true;
+            }
+            pos = next + 1;
+        }
+    }
+
+#if defined(LINR_SIMD_SSE2)
+    /**
+     * @brief Walks a string one classified block at a time, answering "next position matching" queries.
+     */
+    class BlockCursor
+    {
+    public:
+        BlockCursor(Str str, char delim) noexcept
+            : m_str{ str }
+            , m_delim{ delim }
+        {
+        }
+
+        /**
+         * @brief Find the first position at or after `from` whose block mask bit is set.
+         *
+         * @param from Start position.
+         * @param select Function that picks (or combines) the mask to search from `simd::Masks`.
+         * @return The position, or the size of the string if there is none.
+         */
+        template <typename Select>
+        std::size_t find(std::size_t from, Select select) noexcept
+        {
+            while (from < m_str.size()) {
+                auto base = from & ~(simd::block_size - 1);
+                load(base);
+
+                if (auto bits = select(m_masks) >> (from - base); bits != 0) {
+                    return std::min(from + static_cast<std::size_t>(simd::lowest_bit(bits)), m_str.size());
+                }
+                from = base + simd::block_size;
+            }
+            return m_str.size();
+        }
+
+        /**
+         * @brief Check whether the mask bit of position `pos` is set, `pos` must be within the string.
+         */
+        template <typename Select>
+        bool test(std::size_t pos, Select select) noexcept
+        {
+            auto base = pos & ~(simd::block_size - 1);
+            load(base);
+            return ((select(m_masks) >> (pos - base)) & 1u) != 0;
+        }
+
+    private:
+        void load(std::size_t base) noexcept
+        {
+            if (base == m_base) {
+                return;
+            }
+            m_base = base;
+
+            auto remaining = m_str.size() - base;
+            if (remaining >= simd::block_size) {
+                m_masks = simd::classify_sse2(m_str.data() + base, m_delim);
+                return;
+            }
+
+            // partial block: pad and mask out the bytes past the end of the string
+            auto block = Arr<char, simd::block_size>{};
+            std::memcpy(block.data(), m_str.data() + base, remaining);
+
+            auto valid = (std::uint64_t{ 1 } << remaining) - 1;
+
+            m_masks            = simd::classify_sse2(block.data(), m_delim);
+            m_masks.m_delim   &= valid;
+            m_masks.m_null    &= valid;
+            m_masks.m_newline &= valid;
+        }
+
+        Str         m_str;
+        char        m_delim;
+        std::size_t m_base  = Str::npos;
+        simd::Masks m_masks = { 0, 0, 0 };
+    };
+
+    /**
+     * @brief Split using block classification, the semantics is identical to `split_scalar`.
+     *
+     * Each 64-byte block of the string is classified into delimiter, null, and newline bitmasks at once, the
+     * token boundaries are then extracted from the masks using bit scans.
+     */
+    template <std::size_t N>
+    Opt<Arr<Str, N>> split_blocks(Str str, char delim) noexcept
+    {
+        Arr<Str, N> res = {};
+
+        auto cursor = BlockCursor{ str, delim };
+
+        const auto line_end      = [](const simd::Masks& m) { return m.m_null | m.m_newline; };
+        const auto non_delim     = [](const simd::Masks& m) { return ~m.m_delim; };
+        const auto delim_or_null = [](const simd::Masks& m) { return m.m_delim | m.m_null; };
+
+        std::size_t i = 0;
+        std::size_t j = 0;
+
+        while (i < N and j < str.size() and not cursor.test(j, line_end)) {
+            j = cursor.find(j, non_delim);
+
+            auto pos = cursor.find(j, delim_or_null);
+
+            if (pos == str.size()) {
+                res[i++] = str.substr(j);
+                break;
+            }
+
+            res[i++] = str.substr(j, pos - j);
+
+            if (cursor.test(pos, line_end)) {
+                break;
+            }
+
+            j = pos + 1;
+        }
+
+        if (i != N) {
+            return std::nullopt;
+        }
+
+        return res;
+    }
+#endif
+}
+
+#endif /* end of include guard: LINR_DETAIL_SPLIT_HPP */
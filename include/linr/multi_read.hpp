@@ -0,0 +1,315 @@
+#ifndef LINR_MULTI_READ_HPP
+#define LINR_MULTI_READ_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/line_reader.hpp"
+#include "linr/detail/read.hpp"
+#include "linr/detail/simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <span>
+#include <vector>
+
+#if defined(__linux__)
+#    include <sys/epoll.h>
+
+namespace linr
+{
+    /**
+     * @brief A line read by a `MultiReader`, along with the source it came from.
+     *
+     * `source` is the id returned by `MultiReader::add`, or `MultiReader::no_source` for an error that isn't
+     * tied to a source (including the end of the last source).
+     */
+    template <typename... Ts>
+    struct SourceResult
+    {
+        std::size_t    source;
+        Results<Ts...> result;
+    };
+}
+
+namespace linr::detail
+{
+    /**
+     * @brief Input of a `MultiReader`: a file descriptor and the data read from it that isn't consumed yet.
+     */
+    struct MultiSource
+    {
+        // next complete line, or the partial line left when the source ended
+        Opt<Str> next_line() noexcept
+        {
+            auto* data = m_buf.data();
+            auto* nl   = simd::find_newline(data + m_scanned, data + m_end);
+
+            if (nl != data + m_end) {
+                auto pos  = static_cast<std::size_t>(nl - data);
+                auto line = Str{ data + m_begin, pos - m_begin };
+                m_begin = m_scanned = pos + 1;
+                return line;
+            }
+
+            m_scanned = m_end;
+            if (m_eof and m_begin != m_end) {
+                auto line = Str{ data + m_begin, m_end - m_begin };
+                m_begin   = m_end;
+                return line;
+            }
+
+            return {};
+        }
+
+        // read once from the descriptor, it's known to be readable so this doesn't block
+        void fill() noexcept
+        {
+            // move the partial line to the front, grow the buffer if the line fills it entirely
+            if (m_begin != 0) {
+                std::memmove(m_buf.data(), m_buf.data() + m_begin, m_end - m_begin);
+                m_end     -= m_begin;
+                m_scanned -= m_begin;
+                m_begin    = 0;
+            }
+            if (m_end == m_buf.size()) {
+                try {
+                    m_buf.resize(m_buf.size() * 2);
+                } catch (...) {
+                    m_error = true;
+                    return;
+                }
+            }
+
+            auto nread = ssize_t{ 0 };
+            do {
+                nread = ::read(m_fd, m_buf.data() + m_end, m_buf.size() - m_end);
+            } while (nread < 0 and errno == EINTR);
+
+            if (nread < 0) {
+                m_error = errno != EAGAIN and errno != EWOULDBLOCK;
+            } else if (nread == 0) {
+                m_eof = true;
+            } else {
+                m_end += static_cast<std::size_t>(nread);
+            }
+        }
+
+        int               m_fd;
+        std::vector<char> m_buf;
+        std::size_t       m_begin   = 0;    // start of unconsumed data
+        std::size_t       m_end     = 0;    // end of valid data
+        std::size_t       m_scanned = 0;    // [m_begin, m_scanned) is known to not contain a newline
+        bool              m_open    = true;
+        bool              m_queued  = false;
+        bool              m_eof     = false;
+        bool              m_error   = false;
+    };
+}
+
+namespace linr
+{
+    /**
+     * @brief Reader that reads lines from many file descriptors at once (e.g. the pipes of child processes),
+     * waiting on all of them with a single `epoll` instance.
+     *
+     * Each source is buffered on its own, a partial line waits in its buffer until the rest arrives. Each
+     * `read` yields one complete line, whichever source it came from, parsed like the other readers do.
+     * Sources with complete lines take turns, so a chatty source can't starve the others.
+     *
+     * The descriptors are not owned, and are neither closed nor switched to non-blocking mode: a source is
+     * only read once per readiness notification. The lines of a source are views into its buffer, valid
+     * until the next `read`. Linux only.
+     */
+    class MultiReader
+    {
+    public:
+        static constexpr std::size_t no_source = static_cast<std::size_t>(-1);
+
+        /**
+         * @brief Create the reader, with no source yet.
+         *
+         * @param size Initial size of the buffer of each source, grown for longer lines.
+         */
+        explicit MultiReader(std::size_t size = 4096) noexcept
+            : m_epoll{ ::epoll_create1(EPOLL_CLOEXEC) }
+            , m_size{ std::max(size, std::size_t{ 2 }) }
+        {
+        }
+
+        ~MultiReader()
+        {
+            if (m_epoll >= 0) {
+                ::close(m_epoll);
+            }
+        }
+
+        MultiReader(MultiReader&&)            = delete;
+        MultiReader& operator=(MultiReader&&) = delete;
+
+        MultiReader(const MultiReader&)            = delete;
+        MultiReader& operator=(const MultiReader&) = delete;
+
+        /**
+         * @brief Start reading from a file descriptor that `epoll` supports (pipe, socket, terminal, ...).
+         *
+         * @param fd The file descriptor.
+         * @return The id of the source, `Error::Unknown` if it can't be watched (e.g. a regular file).
+         */
+        Result<std::size_t> add(int fd) noexcept
+        {
+            if (m_epoll < 0) {
+                return make_error<std::size_t>(Error::Unknown);
+            }
+
+            auto id = m_sources.size();
+            try {
+                m_sources.push_back(detail::MultiSource{ .m_fd = fd, .m_buf = std::vector<char>(m_size) });
+            } catch (...) {
+                return make_error<std::size_t>(Error::Unknown);
+            }
+
+            auto event     = epoll_event{};
+            event.events   = EPOLLIN;
+            event.data.u64 = id;
+            if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) != 0) {
+                m_sources.pop_back();
+                return make_error<std::size_t>(Error::Unknown);
+            }
+
+            ++m_open;
+            return make_result<std::size_t>(id);
+        }
+
+        /**
+         * @brief Stop reading from a source, its buffered lines are dropped and its end isn't reported.
+         *
+         * @param source The id of the source.
+         */
+        void remove(std::size_t source) noexcept
+        {
+            if (source < m_sources.size() and m_sources[source].m_open) {
+                close(source);
+                m_sources[source].m_buf = {};
+            }
+        }
+
+        /**
+         * @brief Number of sources that haven't ended or been removed.
+         */
+        std::size_t active() const noexcept { return m_open; }
+
+        /**
+         * @brief Read the next complete line from any source as tuple, waiting for one if there is none.
+         *
+         * The end of a source is reported once, as `Error::EndOfFile` with its id (after its last line, which
+         * may lack a newline), a failed read as `Error::Unknown` with its id, and the source is removed. Once
+         * no source is left, `Error::EndOfFile` is returned with `no_source`.
+         *
+         * @param delim Delimiter, only `char` so you can't use unicode.
+         */
+        template <Parseable... Ts>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+        SourceResult<Ts...> read(char delim = ' ') noexcept
+        {
+            while (true) {
+                while (not m_ready.empty()) {
+                    auto  id     = m_ready.front();
+                    auto& source = m_sources[id];
+                    m_ready.pop_front();
+                    source.m_queued = false;
+
+                    if (not source.m_open) {
+                        continue;
+                    }
+
+                    if (auto line = source.next_line()) {
+                        // back of the queue, the other sources get a turn before its next line
+                        enqueue(id);
+                        return { id, detail::parse_line<Ts...>(*line, delim, m_context) };
+                    }
+
+                    if (source.m_eof or source.m_error) {
+                        auto error = source.m_error ? Error::Unknown : Error::EndOfFile;
+                        close(id);
+                        return { id, make_error<Tup<Ts...>>(error) };
+                    }
+                }
+
+                if (m_open == 0) {
+                    return { no_source, make_error<Tup<Ts...>>(Error::EndOfFile) };
+                }
+                if (not wait()) {
+                    return { no_source, make_error<Tup<Ts...>>(Error::Unknown) };
+                }
+            }
+        }
+
+        /**
+         * @brief Set the context handed to the parsers, see `BasicBufReader::set_context`.
+         */
+        void set_context(ParseContext context) { m_context = context; }
+
+        ParseContext get_context() const { return m_context; }
+
+    private:
+        // wait until some sources are readable, read each of them once and queue them
+        bool wait() noexcept
+        {
+            auto events = std::array<epoll_event, 64>{};
+            auto count  = 0;
+            do {
+                count = ::epoll_wait(m_epoll, events.data(), static_cast<int>(events.size()), -1);
+            } while (count < 0 and errno == EINTR);
+
+            if (count < 0) {
+                return false;
+            }
+
+            for (const auto& event : std::span{ events.data(), static_cast<std::size_t>(count) }) {
+                auto id = static_cast<std::size_t>(event.data.u64);
+                if (not m_sources[id].m_open) {
+                    continue;
+                }
+                m_sources[id].fill();
+                if (not enqueue(id)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool enqueue(std::size_t id) noexcept
+        {
+            if (m_sources[id].m_queued) {
+                return true;
+            }
+            try {
+                m_ready.push_back(id);
+            } catch (...) {
+                return false;
+            }
+            m_sources[id].m_queued = true;
+            return true;
+        }
+
+        void close(std::size_t id) noexcept
+        {
+            ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, m_sources[id].m_fd, nullptr);
+            m_sources[id].m_open = false;
+            --m_open;
+        }
+
+        int                              m_epoll;
+        std::size_t                      m_size;
+        std::size_t                      m_open = 0;
+        std::vector<detail::MultiSource> m_sources;
+        std::deque<std::size_t>          m_ready;    // sources that may have a line or an end to report
+        ParseContext                     m_context = {};
+    };
+}
+#endif
+
+#endif /* end of include guard: LINR_MULTI_READ_HPP */
@@ -0,0 +1,274 @@
+#ifndef LINR_PARALLEL_READ_HPP
+#define LINR_PARALLEL_READ_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/line_reader.hpp"
+#include "linr/detail/read.hpp"
+#include "linr/detail/simd.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#if defined(LINR_POSIX)
+#    include <fcntl.h>
+
+namespace linr
+{
+    /**
+     * @brief Outcome of a parallel read.
+     *
+     * `rows` holds the parsed lines in input order up to the first error, so the (zero-based) line index of
+     * `error` is `rows.size()`.
+     */
+    template <typename... Ts>
+    struct ParallelResult
+    {
+        std::vector<Tup<Ts...>> rows;
+        Opt<Error>              error;
+    };
+}
+
+namespace linr::detail
+{
+    /**
+     * @brief Read-only mapping of a regular file, from a given offset to its end.
+     */
+    class FileMapping
+    {
+    public:
+        FileMapping(int fd, off_t offset) noexcept
+        {
+            struct stat info = {};
+            if (fstat(fd, &info) != 0 or not S_ISREG(info.st_mode) or offset < 0) {
+                return;
+            }
+
+            m_ok   = true;
+            m_size = static_cast<std::size_t>(info.st_size);
+            if (m_size == 0) {
+                return;
+            }
+
+            auto* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                m_ok   = false;
+                m_size = 0;
+                return;
+            }
+            madvise(data, m_size, MADV_WILLNEED);
+
+            m_data   = static_cast<const char*>(data);
+            m_offset = std::min(static_cast<std::size_t>(offset), m_size);
+        }
+
+        ~FileMapping()
+        {
+            if (m_data) {
+                munmap(const_cast<char*>(m_data), m_size);
+            }
+        }
+
+        FileMapping(FileMapping&&)            = delete;
+        FileMapping& operator=(FileMapping&&) = delete;
+
+        FileMapping(const FileMapping&)            = delete;
+        FileMapping& operator=(const FileMapping&) = delete;
+
+        bool ok() const noexcept { return m_ok; }
+
+        Str view() const noexcept { return { m_data + m_offset, m_size - m_offset }; }
+
+    private:
+        const char* m_data   = nullptr;
+        std::size_t m_size   = 0;
+        std::size_t m_offset = 0;
+        bool        m_ok     = false;
+    };
+
+    template <typename... Ts>
+    struct Chunk
+    {
+        Str                     m_data;
+        std::vector<Tup<Ts...>> m_rows;
+        Opt<Error>              m_error;
+    };
+
+    /**
+     * @brief Cut the data into at most `count` chunks of about the same size, each ending after a newline.
+     */
+    inline std::vector<Str> split_chunks(Str data, std::size_t count)
+    {
+        auto chunks = std::vector<Str>{};
+        auto begin  = std::size_t{ 0 };
+
+        for (auto i = std::size_t{ 1 }; i <= count and begin != data.size(); ++i) {
+            auto end = std::max(data.size() / count * i, begin);
+            if (i == count) {
+                end = data.size();
+            } else if (end != 0 and data[end - 1] != '\n') {
+                const auto* nl = simd::find_newline(data.data() + end, data.data() + data.size());
+                end = static_cast<std::size_t>(nl - data.data()) + (nl != data.data() + data.size() ? 1 : 0);
+            }
+
+            if (end != begin) {
+                chunks.push_back(data.substr(begin, end - begin));
+            }
+            begin = end;
+        }
+
+        return chunks;
+    }
+
+    /**
+     * @brief Parse every line of the chunk, stopping at the first error (`Error::Unknown` if the rows can't
+     * grow).
+     */
+    template <Parseable... Ts>
+    void parse_chunk(Chunk<Ts...>& chunk, char delim) noexcept
+    {
+        const auto* first = chunk.m_data.data();
+        const auto* last  = first + chunk.m_data.size();
+
+        while (first != last) {
+            const auto* nl = simd::find_newline(first, last);
+
+            auto row = parse_line<Ts...>(Str{ first, nl }, delim, ParseContext{});
+            if (not row) {
+                chunk.m_error = row.error();
+                return;
+            }
+
+            try {
+                chunk.m_rows.push_back(std::move(row).value());
+            } catch (...) {
+                chunk.m_error = Error::Unknown;
+                return;
+            }
+
+            first = nl != last ? nl + 1 : last;
+        }
+    }
+}
+
+namespace linr
+{
+    /**
+     * @brief Read and parse all the lines of a regular file using multiple threads.
+     *
+     * The file is mapped into memory from the current offset of the file descriptor and cut into one byte
+     * range per thread, each range extended to end after a newline. The ranges are parsed concurrently and
+     * the rows are put back together in input order. Small files use fewer threads.
+     *
+     * @param fd File descriptor of a regular file, its offset is not advanced.
+     * @param threads Number of threads, 0 to use the number of hardware threads.
+     * @param delim Delimiter, only `char` so you can't use unicode.
+     * @return The rows up to the first error, and the error (`Error::Unknown` if the file can't be mapped or
+     * the memory runs out).
+     */
+    template <Parseable... Ts>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    ParallelResult<Ts...> parallel_read(int fd, unsigned threads = 0, char delim = ' ') noexcept
+    {
+        static_assert(
+            (not detail::Borrowed<Ts> and ...),
+            "linr::parallel_read unmaps the file before returning, read std::string instead of string views"
+        );
+
+        // below this size per chunk, starting a thread costs more than it saves
+        constexpr auto min_chunk_size = std::size_t{ 1 } << 16;
+
+        auto result  = ParallelResult<Ts...>{};
+        auto mapping = detail::FileMapping{ fd, lseek(fd, 0, SEEK_CUR) };
+        if (not mapping.ok()) {
+            result.error = Error::Unknown;
+            return result;
+        }
+
+        if (threads == 0) {
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        auto data  = mapping.view();
+        auto count = std::clamp(data.size() / min_chunk_size, std::size_t{ 1 }, std::size_t{ threads });
+
+        auto chunks = std::vector<detail::Chunk<Ts...>>{};
+        try {
+            for (auto range : detail::split_chunks(data, count)) {
+                chunks.push_back({ .m_data = range, .m_rows = {}, .m_error = {} });
+            }
+        } catch (...) {
+            result.error = Error::Unknown;
+            return result;
+        }
+
+        // the calling thread takes the first chunk, a chunk whose thread can't be started (or stored) is
+        // parsed inline
+        auto workers = std::vector<std::jthread>{};
+        for (auto i = 1u; i < chunks.size(); ++i) {
+            try {
+                workers.emplace_back([&chunk = chunks[i], delim] { detail::parse_chunk(chunk, delim); });
+            } catch (...) {
+                detail::parse_chunk(chunks[i], delim);
+            }
+        }
+        if (not chunks.empty()) {
+            detail::parse_chunk(chunks[0], delim);
+        }
+        workers.clear();
+
+        auto total = std::size_t{ 0 };
+        for (const auto& chunk : chunks) {
+            total += chunk.m_rows.size();
+            if (chunk.m_error) {
+                break;
+            }
+        }
+
+        try {
+            result.rows.reserve(total);
+            for (auto& chunk : chunks) {
+                std::ranges::move(chunk.m_rows, std::back_inserter(result.rows));
+                if (chunk.m_error) {
+                    result.error = chunk.m_error;
+                    break;
+                }
+            }
+        } catch (...) {
+            result.error = Error::Unknown;
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Read and parse all the lines of a regular file using multiple threads.
+     *
+     * @param path Path of the file.
+     * @param threads Number of threads, 0 to use the number of hardware threads.
+     * @param delim Delimiter, only `char` so you can't use unicode.
+     * @return The rows up to the first error, and the error (`Error::Unknown` if the file can't be opened).
+     */
+    template <Parseable... Ts>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    ParallelResult<Ts...> parallel_read(
+        const std::filesystem::path& path,
+        unsigned                     threads = 0,
+        char                         delim   = ' '
+    ) noexcept
+    {
+        auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            auto result  = ParallelResult<Ts...>{};
+            result.error = Error::Unknown;
+            return result;
+        }
+
+        auto result = parallel_read<Ts...>(fd, threads, delim);
+        ::close(fd);
+        return result;
+    }
+}
+#endif
+
+#endif /* end of include guard: LINR_PARALLEL_READ_HPP */
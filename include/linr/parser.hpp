@@ -2,10 +2,12 @@
 #define LINR_PARSER_HPP
 
 #include "linr/common.hpp"
+#include "linr/detail/aggregate.hpp"
 #include "linr/detail/default_parser.hpp"
 #include "linr/util.hpp"
 
 #include <span>
+#include <type_traits>
 
 namespace linr
 {
@@ -15,91 +17,267 @@ namespace linr
      * @tparam T Type to be parsed
      *
      * User can create a parser for a type by specializing this struct. The shape of the struct should match
-     * the `CustomParseable` concept.
+     * the `CustomParseable` concept: a `parse(Str)` member function, or `parse(Str, const ParseContext&)` for
+     * a parser that needs the context (e.g. to allocate from its memory resource).
      */
     template <typename T>
     struct CustomParser;
 
+    namespace detail
+    {
+        template <typename P, typename T>
+        concept ContextParser = requires (const P p, Str str, const ParseContext& context) {
+            { p.parse(str, context) } noexcept -> std::same_as<Result<T>>;
+        };
+
+        template <typename P, typename T>
+        concept PlainParser = requires (const P p, Str str) {
+            { p.parse(str) } noexcept -> std::same_as<Result<T>>;
+        };
+    }
+
     template <typename T>
-    concept CustomParseable = requires (const CustomParser<T> p, Str str) {
-        { p.parse(str) } noexcept -> std::same_as<Result<T>>;
-    };
+    concept CustomParseable = detail::PlainParser<CustomParser<T>, T>
+                           or detail::ContextParser<CustomParser<T>, T>;
 
     template <typename T>
-    concept DefaultParseable = requires (const detail::DefaultParser<T> p, Str str) {
-        { p.parse(str) } noexcept -> std::same_as<Result<T>>;
-    };
+    concept DefaultParseable = detail::PlainParser<detail::DefaultParser<T>, T>
+                            or detail::ContextParser<detail::DefaultParser<T>, T>;
 
     template <typename T>
     concept Parseable = DefaultParseable<T> or CustomParseable<T>;
 
     /**
      * @brief Helper function that calls the specialized `Parser` member function.
+     *
+     * @param str The string to parse.
+     * @param context The context, only passed to the parsers that take one.
      */
     template <Parseable T>
-    Result<T> parse(Str str) noexcept
+    Result<T> parse(Str str, const ParseContext& context = {}) noexcept
     {
-        if constexpr (CustomParseable<T>) {
-            return CustomParser<T>{}.parse(str);
+        using Parser = std::conditional_t<CustomParseable<T>, CustomParser<T>, detail::DefaultParser<T>>;
+
+        if constexpr (detail::ContextParser<Parser, T>) {
+            return Parser{}.parse(str, context);
         } else {
-            return detail::DefaultParser<T>{}.parse(str);
+            return Parser{}.parse(str);
+        }
+    }
+
+    namespace detail
+    {
+        /**
+         * @brief Types that can be parsed straight into a default initialized destination.
+         *
+         * Assigning to them is the same as constructing them. Not the case in general: move assigning an
+         * allocator-aware value (like `std::pmr::string`) doesn't carry its allocator over.
+         */
+        template <typename T>
+        concept AssignInPlace = std::default_initializable<T> and std::is_trivially_copyable_v<T>;
+
+        /**
+         * @brief Parse a value and store it into `out`, or record the error.
+         *
+         * `out` is either the destination itself (see `AssignInPlace`) or an `Opt` of it.
+         */
+        template <typename T, typename Out>
+        bool parse_field(Str str, Out& out, Opt<Error>& error, const ParseContext& context) noexcept
+        {
+            auto value = parse<T>(str, context);
+            if (not value) {
+                error = value.error();
+                return false;
+            }
+
+            if constexpr (std::same_as<Out, Opt<T>>) {
+                out.emplace(std::move(value).value());
+            } else {
+                out = std::move(value).value();
+            }
+            return true;
         }
     }
 
     /**
      * @brief Helper function that parse span of str directly into tuple.
      *
+     * The values are parsed in order and the parsing stops at the first error. When every type is trivially
+     * copyable the values are stored straight into the tuple of the result, otherwise each is moved once
+     * into it.
+     *
      * @tparam Ts The types to parse.
      * @param values Span of string views, the extent matches the number of types.
+     * @param context The parse context.
      * @return The resulting parsed values as tuple or an error.
      */
     template <typename... Ts>
-    constexpr Results<Ts...> parse_into_tuple(std::span<Str, sizeof...(Ts)> values) noexcept
+    constexpr Results<Ts...> parse_into_tuple(
+        std::span<Str, sizeof...(Ts)> values,
+        const ParseContext&           context = {}
+    ) noexcept
     {
         using Seq = std::index_sequence_for<Ts...>;
 
-        const auto multiparse = [&]<std::size_t... Is>(std::index_sequence<Is...>) -> Tup<Result<Ts>...> {
-            return { parse<Ts>(values[Is])... };
-        };
-        auto maybe_result = multiparse(Seq{});
-
         auto error = Opt<Error>{};
-        util::for_each_tuple(maybe_result, [&]<std::size_t I, typename T>(T& value) {
-            if (not error.has_value() and not value) {
-                error = value.error();
+
+        if constexpr ((detail::AssignInPlace<Ts> and ...)) {
+            auto result = make_result<Tup<Ts...>>();
+
+            const auto parse_all = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return (detail::parse_field<Ts>(values[Is], std::get<Is>(*result), error, context) and ...);
+            };
+            if (not parse_all(Seq{})) {
+                result = make_error<Tup<Ts...>>(error.value());
             }
-        });
-        if (error.has_value()) {
-            return make_error<Tup<Ts...>>(error.value());
-        }
+            return result;
+        } else {
+            auto fields = Tup<Opt<Ts>...>{};
 
-        const auto flatten = [&]<std::size_t... Is>(std::index_sequence<Is...>) -> Tup<Ts...> {
-            return { std::move(std::get<Is>(maybe_result)).value()... };
-        };
-        return make_result<Tup<Ts...>>(flatten(Seq{}));
+            const auto parse_all = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return (detail::parse_field<Ts>(values[Is], std::get<Is>(fields), error, context) and ...);
+            };
+            if (not parse_all(Seq{})) {
+                return make_error<Tup<Ts...>>(error.value());
+            }
+
+            const auto flatten = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return make_result<Tup<Ts...>>(std::move(*std::get<Is>(fields))...);
+            };
+            return flatten(Seq{});
+        }
     }
 
     /**
      * @brief Helper function that parse span of str into array.
      *
+     * Same as `parse_into_tuple`: parsed in order, stops at the first error, and stored straight into the
+     * array of the result when `T` is trivially copyable.
+     *
      * @tparam T The type of the element of the array.
      * @param values Span of string views, the extent matches the number of types.
+     * @param context The parse context.
      * @return The resulting parsed values as array or an error.
      */
     template <typename T, std::size_t N>
-    constexpr AResults<T, N> parse_array(std::span<Str, N> values) noexcept
+    constexpr AResults<T, N> parse_array(std::span<Str, N> values, const ParseContext& context = {}) noexcept
     {
-        auto maybe_result = Arr<Result<T>, N>{};
-        for (auto i = 0u; i < N; ++i) {
-            if (auto& result = maybe_result[i] = parse<T>(values[i]); not result) {
-                return make_error<Arr<T, N>>(result.error());
+        auto error = Opt<Error>{};
+
+        if constexpr (detail::AssignInPlace<T>) {
+            auto result = make_result<Arr<T, N>>();
+            for (auto i = 0u; i < N; ++i) {
+                if (not detail::parse_field<T>(values[i], (*result)[i], error, context)) {
+                    result = make_error<Arr<T, N>>(error.value());
+                    break;
+                }
             }
+            return result;
+        } else {
+            auto fields = Arr<Opt<T>, N>{};
+            for (auto i = 0u; i < N; ++i) {
+                if (not detail::parse_field<T>(values[i], fields[i], error, context)) {
+                    return make_error<Arr<T, N>>(error.value());
+                }
+            }
+
+            const auto flatten = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return make_result<Arr<T, N>>(Arr<T, N>{ std::move(*fields[Is])... });
+            };
+            return flatten(std::make_index_sequence<N>{});
         }
+    }
 
-        const auto flatten = [&]<std::size_t... Is>(std::index_sequence<Is...>) -> Arr<T, N> {
-            return { std::move(std::get<Is>(maybe_result)).value()... };
-        };
-        return make_result<Arr<T, N>>(flatten(std::make_index_sequence<N>{}));
+    namespace detail
+    {
+        template <typename>
+        inline constexpr bool parseable_fields = false;
+
+        template <typename... Fs>
+        inline constexpr bool parseable_fields<Tup<Fs...>> = ((Parseable<Fs> and std::movable<Fs>) and ...);
+
+        template <typename>
+        inline constexpr bool assign_in_place_fields = false;
+
+        template <typename... Fs>
+        inline constexpr bool assign_in_place_fields<Tup<Fs...>> = (AssignInPlace<Fs> and ...);
+
+        template <typename>
+        inline constexpr bool borrowed_fields = false;
+
+        template <typename... Fs>
+        inline constexpr bool borrowed_fields<Tup<Fs...>> = (Borrowed<Fs> or ...);
+    }
+
+    /**
+     * @brief Aggregates whose fields are all parseable, read one field per value without a `CustomParser`.
+     *
+     * A type with a parser of its own (e.g. a `CustomParser` specialization) is parsed from a single value
+     * instead. Aggregates with base classes, array fields, or more than `detail::max_aggregate_fields`
+     * fields are not supported.
+     */
+    template <typename T>
+    concept ParseableAggregate = std::is_class_v<T> and std::is_aggregate_v<T> and (not std::is_union_v<T>)
+                             and (not Parseable<T>) and (not detail::has_base<T>())
+                             and (detail::field_count<T>() >= 1)
+                             and (detail::field_count<T>() <= detail::max_aggregate_fields)
+                             and (detail::field_count<T>() == detail::flat_field_count<T>())
+                             and detail::parseable_fields<detail::FieldTypes<T>>;
+
+    /**
+     * @brief Helper function that parse span of str directly into the fields of an aggregate.
+     *
+     * Same as `parse_into_tuple`: parsed in order and stops at the first error. When every field is trivially
+     * copyable the values are stored straight into the fields of the result, otherwise each is moved once
+     * into it.
+     *
+     * @tparam T The aggregate type.
+     * @param values Span of string views, the extent matches the number of fields.
+     * @param context The parse context.
+     * @return The resulting aggregate or an error.
+     */
+    template <ParseableAggregate T>
+    constexpr Result<T> parse_into_aggregate(
+        std::span<Str, detail::field_count<T>()> values,
+        const ParseContext&                      context = {}
+    ) noexcept
+    {
+        using detail::parse_field, detail::FieldType;
+
+        using Fields = detail::FieldTypes<T>;
+        using Seq    = std::make_index_sequence<std::tuple_size_v<Fields>>;
+
+        auto error = Opt<Error>{};
+
+        if constexpr (std::default_initializable<T> and detail::assign_in_place_fields<Fields>) {
+            auto result = make_result<T>();
+            auto fields = detail::tie_fields(*result);
+
+            const auto parse_all = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return (
+                    parse_field<FieldType<T, Is>>(values[Is], std::get<Is>(fields), error, context)
+                    and ...
+                );
+            };
+            if (not parse_all(Seq{})) {
+                result = make_error<T>(error.value());
+            }
+            return result;
+        } else {
+            const auto parse_all = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                auto fields = Tup<Opt<FieldType<T, Is>>...>{};
+
+                auto ok = (
+                    parse_field<FieldType<T, Is>>(values[Is], std::get<Is>(fields), error, context)
+                    and ...
+                );
+                if (not ok) {
+                    return make_error<T>(error.value());
+                }
+                return make_result<T>(T{ std::move(*std::get<Is>(fields))... });
+            };
+            return parse_all(Seq{});
+        }
     }
 }
 
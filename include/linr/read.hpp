@@ -15,6 +15,11 @@ namespace linr
         requires (sizeof...(Ts) > 1) and (std::movable<Ts> and ...)
     Results<Ts...> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
     {
+        static_assert(
+            (not detail::Borrowed<Ts> and ...),
+            "linr::read uses a temporary line buffer, read string views with a BufReader instead"
+        );
+
         auto reader = detail::Reader{};
         return detail::read_impl<Ts...>(stdin, reader, prompt, delim);
     }
@@ -29,6 +34,11 @@ namespace linr
         requires std::movable<T>
     Result<T> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
     {
+        static_assert(
+            not detail::Borrowed<T>,
+            "linr::read uses a temporary line buffer, read string views with a BufReader instead"
+        );
+
         auto reader = detail::Reader{};
         auto result = detail::read_impl<T>(stdin, reader, prompt, delim);
         if (result) {
@@ -61,9 +71,54 @@ namespace linr
     template <typename T, std::size_t N>
     AResults<T, N> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
     {
+        static_assert(
+            not detail::Borrowed<T>,
+            "linr::read uses a temporary line buffer, read string views with a BufReader instead"
+        );
+
         auto reader = detail::Reader{};
         return detail::read_impl<T, N>(stdin, reader, prompt, delim);
     }
+
+    /**
+     * @brief Read the fields of an aggregate from stdin, one value per field in declaration order.
+     *
+     * @param prompt The prompt.
+     * @param delim Delimiter, only `char` so you can't use unicode.
+     */
+    template <ParseableAggregate T>
+    Result<T> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
+    {
+        static_assert(
+            not detail::borrowed_fields<detail::FieldTypes<T>>,
+            "linr::read uses a temporary line buffer, read string views with a BufReader instead"
+        );
+
+        auto reader = detail::Reader{};
+        return detail::read_impl<T>(stdin, reader, prompt, delim);
+    }
+
+    /**
+     * @brief Read all the values of a line from stdin as a vector.
+     *
+     * @param prompt The prompt.
+     * @param delim Delimiter, only `char` so you can't use unicode.
+     */
+    template <detail::ParseableVector V>
+    Result<V> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
+    {
+        static_assert(
+            not detail::Borrowed<typename V::value_type>,
+            "linr::read uses a temporary line buffer, read string views with a BufReader instead"
+        );
+
+        auto reader = detail::Reader{};
+        auto values = V{};
+        if (auto error = detail::read_into_impl(stdin, reader, prompt, values, delim)) {
+            return make_error<V>(*error);
+        }
+        return make_result<V>(std::move(values));
+    }
 }
 
 #endif /* end of include guard: LINR_READ_HPP */
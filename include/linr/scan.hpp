@@ -0,0 +1,257 @@
+#ifndef LINR_SCAN_HPP
+#define LINR_SCAN_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/line_reader.hpp"
+#include "linr/detail/probe.hpp"
+#include "linr/detail/simd.hpp"
+#include "linr/parser.hpp"
+
+#include <cstddef>
+#include <span>
+
+namespace linr
+{
+    /**
+     * @brief String literal usable as a template argument, e.g. `scan<"x={} y={}", int, int>`.
+     */
+    template <std::size_t N>
+    struct FixedString
+    {
+        constexpr FixedString(const char (&str)[N]) noexcept
+        {
+            for (auto i = 0u; i < N; ++i) {
+                m_data[i] = str[i];
+            }
+        }
+
+        constexpr Str view() const noexcept { return { m_data, N - 1 }; }
+
+        char m_data[N] = {};
+    };
+}
+
+namespace linr::detail
+{
+    /**
+     * @brief A scan pattern split at compile time into its literal segments.
+     *
+     * `{}` is a placeholder, `{{` and `}}` are literal braces. A pattern with `n` placeholders has `n + 1`
+     * literal segments (possibly empty), the `i`-th placeholder sits between segment `i` and `i + 1`.
+     */
+    template <FixedString Pattern>
+    struct CompiledPattern
+    {
+        struct Info
+        {
+            std::size_t m_count    = 0;
+            bool        m_valid    = true;     // no unmatched brace
+            bool        m_adjacent = false;    // two placeholders with nothing in between
+        };
+
+        static constexpr Info info() noexcept
+        {
+            auto str  = Pattern.view();
+            auto info = Info{};
+            auto size = std::size_t{ 0 };    // size of the current literal segment
+
+            for (auto i = 0u; i < str.size(); ++i) {
+                if (str.substr(i, 2) == "{}") {
+                    info.m_adjacent = info.m_adjacent or (info.m_count != 0 and size == 0);
+                    ++info.m_count;
+                    size = 0;
+                    ++i;
+                } else if (str.substr(i, 2) == "{{" or str.substr(i, 2) == "}}") {
+                    ++size;
+                    ++i;
+                } else if (str[i] == '{' or str[i] == '}') {
+                    info.m_valid = false;
+                } else {
+                    ++size;
+                }
+            }
+
+            return info;
+        }
+
+        static constexpr auto count = info().m_count;
+
+        struct Segments
+        {
+            Arr<char, sizeof(Pattern.m_data)> m_text;       // the literal segments, unescaped, back to back
+            Arr<std::size_t, count + 2>       m_bounds;     // segment `i` is `[m_bounds[i], m_bounds[i + 1])`
+        };
+
+        static constexpr Segments split() noexcept
+        {
+            auto str      = Pattern.view();
+            auto segments = Segments{ {}, {} };
+            auto size     = std::size_t{ 0 };
+            auto index    = std::size_t{ 1 };
+
+            for (auto i = 0u; i < str.size(); ++i) {
+                if (str.substr(i, 2) == "{}") {
+                    segments.m_bounds[index++] = size;
+                    ++i;
+                } else if (str.substr(i, 2) == "{{" or str.substr(i, 2) == "}}") {
+                    segments.m_text[size++] = str[i++];
+                } else {
+                    segments.m_text[size++] = str[i];
+                }
+            }
+            segments.m_bounds[index] = size;
+
+            return segments;
+        }
+
+        static constexpr auto segments = split();
+
+        static constexpr Str literal(std::size_t i) noexcept
+        {
+            auto first = segments.m_bounds[i];
+            return { segments.m_text.data() + first, segments.m_bounds[i + 1] - first };
+        }
+    };
+
+    // compared char by char: the literals are short, and `memcmp` on a segment of the pattern reads as an
+    // overread of the pattern to `-Wstringop-overread`, which doesn't see where the segment ends
+    inline bool match_literal(Str line, std::size_t pos, Str literal) noexcept
+    {
+        if (line.size() - pos < literal.size()) {
+            return false;
+        }
+        for (auto i = 0u; i < literal.size(); ++i) {
+            if (line[pos + i] != literal[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Match the literal segments of the pattern against the line, cutting out the placeholders.
+     *
+     * A placeholder extends to the first occurrence of the literal that follows it, the last one to the
+     * trailing literal at the end of the line. The whole line must match.
+     */
+    template <typename P>
+    bool match_pattern(Str line, std::span<Str, P::count> tokens) noexcept
+    {
+        auto pos = P::literal(0).size();
+        if (not match_literal(line, 0, P::literal(0))) {
+            return false;
+        }
+
+        for (auto i = 0u; i + 1 < P::count; ++i) {
+            auto next  = P::literal(i + 1);
+            auto found = line.find(next, pos);
+            if (found == Str::npos) {
+                return false;
+            }
+            tokens[i] = line.substr(pos, found - pos);
+            pos       = found + next.size();
+        }
+
+        auto last = P::literal(P::count);
+        if (line.size() - pos < last.size() or not match_literal(line, line.size() - last.size(), last)) {
+            return false;
+        }
+        tokens[P::count - 1] = line.substr(pos, line.size() - last.size() - pos);
+
+        return true;
+    }
+}
+
+namespace linr
+{
+    /**
+     * @brief Parse a line with a fixed shape into a tuple, e.g. `scan_line<"x={} y={}", int, float>(line)`.
+     *
+     * The pattern is split at compile time: its literal text is matched in place and each placeholder
+     * `{}` is parsed with the parser of its type, there's no separate split pass. The match is exact,
+     * whitespace included. Write `{{` and `}}` for literal braces. Two placeholders must be separated by
+     * some literal text, a placeholder ends at the first occurrence of the literal that follows it.
+     *
+     * @param line The line, it ends at the first newline (or null character).
+     * @param context The parse context.
+     * @return The parsed values, or `Error::InvalidInput` if the line doesn't match the pattern.
+     */
+    template <FixedString Pattern, Parseable... Ts>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    Results<Ts...> scan_line(Str line, const ParseContext& context = {}) noexcept
+    {
+        using P = detail::CompiledPattern<Pattern>;
+
+        static_assert(P::info().m_valid, "unmatched brace in the scan pattern, write '{{' or '}}' instead");
+        static_assert(P::count == sizeof...(Ts), "the number of placeholders must match the number of types");
+        static_assert(
+            not P::info().m_adjacent,
+            "placeholders of a scan pattern must be separated by literals"
+        );
+
+        const auto* end = detail::simd::find_line_end(line.data(), line.data() + line.size());
+        line            = line.substr(0, static_cast<std::size_t>(end - line.data()));
+
+        auto tokens = Arr<Str, sizeof...(Ts)>{};
+        if (not detail::match_pattern<P>(line, tokens)) {
+            return make_error<Tup<Ts...>>(Error::InvalidInput);
+        }
+        return parse_into_tuple<Ts...>(tokens, context);
+    }
+}
+
+namespace linr::detail
+{
+    template <FixedString Pattern, Parseable... Ts, typename S, LineReader<S> R>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    Results<Ts...> scan_impl(S stream, R& reader, Opt<Str> prompt, const ParseContext& context = {}) noexcept
+    {
+        if (stream_error(stream, reader)) {
+            return make_error<Tup<Ts...>>(Error::Unknown);
+        }
+
+        if (prompt) {
+            std::fwrite(prompt->data(), sizeof(Str::value_type), prompt->size(), stdout);
+        }
+
+        auto line = reader.readline(stream);
+        if (not line) {
+            auto error = stream_error(stream, reader) ? Error::Unknown : Error::EndOfFile;
+            return make_error<Tup<Ts...>>(error);
+        }
+
+        // the pattern is matched and the values parsed in one pass, reported as the parse phase
+        auto probe  = probe_of(reader);
+        auto mark   = probe.start();
+        auto result = scan_line<Pattern, Ts...>(line->view(), context);
+        probe.finish(Phase::Parse, mark, line->view().size());
+
+        if (not result) {
+            probe.fail(result.error());
+        }
+        return result;
+    }
+}
+
+namespace linr
+{
+    /**
+     * @brief Read a line from stdin and parse it with a pattern, see `scan_line`.
+     *
+     * @param prompt The prompt.
+     */
+    template <FixedString Pattern, Parseable... Ts>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    Results<Ts...> scan(Opt<Str> prompt = std::nullopt) noexcept
+    {
+        static_assert(
+            (not detail::Borrowed<Ts> and ...),
+            "linr::scan uses a temporary line buffer, scan string views with a BufReader instead"
+        );
+
+        auto reader = detail::Reader{};
+        return detail::scan_impl<Pattern, Ts...>(stdin, reader, prompt);
+    }
+}
+
+#endif /* end of include guard: LINR_SCAN_HPP */
@@ -0,0 +1,129 @@
+#ifndef LINR_STATS_HPP
+#define LINR_STATS_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/probe.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+namespace linr
+{
+    /**
+     * @brief What a reader with stats keeps track of.
+     */
+    enum class StatsLevel : std::uint8_t
+    {
+        Counters,    // the counters only
+        Timed,       // the counters and the time spent in each phase, two clock reads per phase
+    };
+
+    /**
+     * @brief Snapshot of the statistics of a reader, see `linr::StatsBufReader`.
+     *
+     * The counters start from the construction of the reader or the last `reset_stats()` call.
+     */
+    struct ReaderStats
+    {
+        std::uint64_t lines    = 0;    // lines read, every physical line of a multi-line CSV record included
+        std::uint64_t bytes    = 0;    // bytes of those lines, newlines excluded
+        std::uint64_t refills  = 0;    // times the backend refilled from the source, 0 for stdio backends
+        std::uint64_t growths  = 0;    // reads that had to grow the line buffer
+        std::size_t   capacity = 0;    // current size of the line buffer, 0 for backends without one
+
+        std::uint64_t invalid_input = 0;    // lines that failed with `Error::InvalidInput`
+        std::uint64_t out_of_range  = 0;    // lines that failed with `Error::OutOfRange`
+
+        // only measured with `StatsLevel::Timed`
+        std::chrono::nanoseconds read_time  = {};    // reading lines, waiting on the source included
+        std::chrono::nanoseconds split_time = {};    // cutting lines into fields
+        std::chrono::nanoseconds parse_time = {};    // parsing the fields into values
+
+        std::uint64_t parse_errors() const noexcept { return invalid_input + out_of_range; }
+    };
+}
+
+namespace linr::detail
+{
+    template <StatsLevel L>
+    struct StatsProbe
+    {
+        using Clock = std::chrono::steady_clock;
+        using Mark  = std::conditional_t<L == StatsLevel::Timed, Clock::time_point, NoProbe::Mark>;
+
+        Mark start() const noexcept
+        {
+            if constexpr (L == StatsLevel::Timed) {
+                return Clock::now();
+            } else {
+                return {};
+            }
+        }
+
+        void finish(Phase phase, Mark mark, [[maybe_unused]] std::size_t bytes) const noexcept
+        {
+            if constexpr (L == StatsLevel::Timed) {
+                auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - mark);
+
+                // clang-format off
+                switch (phase) {
+                case Phase::Read:   m_stats->read_time  += elapsed; break;
+                case Phase::Split:  m_stats->split_time += elapsed; break;
+                case Phase::Parse:  m_stats->parse_time += elapsed; break;
+                }
+                // clang-format on
+            }
+        }
+
+        void fail(Error error) const noexcept
+        {
+            if (error == Error::InvalidInput) {
+                ++m_stats->invalid_input;
+            } else if (error == Error::OutOfRange) {
+                ++m_stats->out_of_range;
+            }
+        }
+
+        void line(std::size_t bytes, bool grew) const noexcept
+        {
+            ++m_stats->lines;
+            m_stats->bytes   += bytes;
+            m_stats->growths += grew ? 1 : 0;
+        }
+
+        ReaderStats* m_stats;
+    };
+
+    /**
+     * @brief Line reader that keeps statistics about the reads of the line reader it wraps.
+     *
+     * The lines, bytes, and buffer growths are counted around `readline`, the refills and the capacity are
+     * taken from the wrapped reader (`refills()` and `capacity()`, when it has them).
+     */
+    template <typename R, StatsLevel L>
+    struct StatsReader : ProbeReader<R, StatsReader<R, L>>
+    {
+        using ProbeReader<R, StatsReader>::ProbeReader;
+
+        StatsProbe<L> probe() noexcept { return { &m_stats }; }
+
+        ReaderStats stats() const noexcept
+        {
+            auto stats     = m_stats;
+            stats.refills  = this->refills() - m_refills_base;
+            stats.capacity = this->capacity();
+            return stats;
+        }
+
+        void reset_stats() noexcept
+        {
+            m_stats        = {};
+            m_refills_base = this->refills();
+        }
+
+        ReaderStats   m_stats;
+        std::uint64_t m_refills_base = 0;
+    };
+}
+
+#endif /* end of include guard: LINR_STATS_HPP */
@@ -0,0 +1,246 @@
+#ifndef LINR_TRACE_HPP
+#define LINR_TRACE_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/probe.hpp"
+
+#include <chrono>
+#include <concepts>
+#include <cstdio>
+#include <type_traits>
+#include <utility>
+
+namespace linr
+{
+    using TraceClock = std::chrono::steady_clock;
+
+    /**
+     * @brief A phase of a read, from its start to its end.
+     *
+     * `bytes` is the size of the line the phase worked on (newline excluded for the read phase).
+     */
+    struct TraceEvent
+    {
+        Phase                  phase;
+        TraceClock::time_point begin;
+        TraceClock::time_point end;
+        std::size_t            bytes;
+    };
+
+    /**
+     * @brief Receiver of the trace events of a reader, see `linr::TracedBufReader`.
+     *
+     * `event()` is called at the end of every phase. It may also have an
+     * `error(Error, TraceClock::time_point)` member function, called when a line fails to split or parse.
+     */
+    template <typename T>
+    concept Tracer = requires (T& tracer, const TraceEvent& event) {
+        { tracer.event(event) } noexcept;
+    };
+
+    /**
+     * @brief Tracer that writes the events in the Chrome trace event format (JSON array).
+     *
+     * Open the file in Perfetto (ui.perfetto.dev) or `chrome://tracing`. Each phase is a complete event with
+     * the number of bytes as argument, each error an instant event. Timestamps are relative to the
+     * construction of the tracer.
+     *
+     * Tracing every line of a bulk read makes a large file, set `min_duration` to only keep the phases that
+     * took at least that long (the stalls); errors are always written.
+     */
+    class ChromeTrace
+    {
+    public:
+        /**
+         * @brief Write the trace to a file, created or truncated.
+         *
+         * @param path The path of the file.
+         * @param min_duration The minimum duration of the phases that are written.
+         */
+        explicit ChromeTrace(const char* path, std::chrono::nanoseconds min_duration = {}) noexcept
+            : m_out{ std::fopen(path, "w") }
+            , m_owned{ true }
+            , m_min_duration{ min_duration }
+        {
+            begin();
+        }
+
+        /**
+         * @brief Write the trace to an open stream, which is left open.
+         *
+         * @param out The stream.
+         * @param min_duration The minimum duration of the phases that are written.
+         */
+        explicit ChromeTrace(std::FILE* out, std::chrono::nanoseconds min_duration = {}) noexcept
+            : m_out{ out }
+            , m_owned{ false }
+            , m_min_duration{ min_duration }
+        {
+            begin();
+        }
+
+        ~ChromeTrace() { close(); }
+
+        ChromeTrace(ChromeTrace&&)            = delete;
+        ChromeTrace& operator=(ChromeTrace&&) = delete;
+
+        ChromeTrace(const ChromeTrace&)            = delete;
+        ChromeTrace& operator=(const ChromeTrace&) = delete;
+
+        void event(const TraceEvent& event) noexcept
+        {
+            if (m_out == nullptr or event.end - event.begin < m_min_duration) {
+                return;
+            }
+
+            std::fprintf(
+                m_out,
+                "%s{\"name\":\"%s\",\"cat\":\"linr\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                "\"pid\":1,\"tid\":1,\"args\":{\"bytes\":%zu}}",
+                separator(),
+                name(event.phase),
+                micros(event.begin - m_origin),
+                micros(event.end - event.begin),
+                event.bytes
+            );
+        }
+
+        void error(Error error, TraceClock::time_point time) noexcept
+        {
+            if (m_out == nullptr) {
+                return;
+            }
+
+            std::fprintf(
+                m_out,
+                "%s{\"name\":\"%s\",\"cat\":\"linr\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,"
+                "\"pid\":1,\"tid\":1}",
+                separator(),
+                name(error),
+                micros(time - m_origin)
+            );
+        }
+
+        bool is_open() const noexcept { return m_out != nullptr; }
+
+        /**
+         * @brief End the JSON array, the events after that are dropped.
+         */
+        void close() noexcept
+        {
+            if (m_out == nullptr) {
+                return;
+            }
+
+            std::fputs("\n]\n", m_out);
+            if (m_owned) {
+                std::fclose(m_out);
+            } else {
+                std::fflush(m_out);
+            }
+            m_out = nullptr;
+        }
+
+    private:
+        void begin() noexcept
+        {
+            if (m_out != nullptr) {
+                std::fputc('[', m_out);
+            }
+        }
+
+        const char* separator() noexcept { return std::exchange(m_first, false) ? "\n" : ",\n"; }
+
+        static double micros(TraceClock::duration duration) noexcept
+        {
+            return std::chrono::duration<double, std::micro>{ duration }.count();
+        }
+
+        static const char* name(Phase phase) noexcept
+        {
+            // clang-format off
+            switch (phase) {
+            case Phase::Read:   return "readline";
+            case Phase::Split:  return "split";
+            case Phase::Parse:  return "parse";
+            }
+            // clang-format on
+
+            return "unknown";
+        }
+
+        static const char* name(Error error) noexcept
+        {
+            // clang-format off
+            switch (error) {
+            case Error::InvalidInput:   return "InvalidInput";
+            case Error::OutOfRange:     return "OutOfRange";
+            case Error::EndOfFile:      return "EndOfFile";
+            case Error::Unknown:        return "Unknown";
+            }
+            // clang-format on
+
+            return "Unknown";
+        }
+
+        std::FILE*               m_out;
+        bool                     m_owned;
+        bool                     m_first        = true;
+        std::chrono::nanoseconds m_min_duration = {};
+        TraceClock::time_point   m_origin       = TraceClock::now();
+    };
+    static_assert(Tracer<ChromeTrace>);
+}
+
+namespace linr::detail
+{
+    template <Tracer T>
+    struct TraceProbe
+    {
+        using Mark = TraceClock::time_point;
+
+        // the clock is only read while a tracer is set
+        Mark start() const noexcept { return m_tracer != nullptr ? TraceClock::now() : Mark{}; }
+
+        void finish(Phase phase, Mark mark, std::size_t bytes) const noexcept
+        {
+            if (m_tracer != nullptr) {
+                m_tracer->event(TraceEvent{ phase, mark, TraceClock::now(), bytes });
+            }
+        }
+
+        void fail(Error error) const noexcept
+        {
+            if constexpr (requires { m_tracer->error(error, TraceClock::now()); }) {
+                if (m_tracer != nullptr) {
+                    m_tracer->error(error, TraceClock::now());
+                }
+            }
+        }
+
+        void line(std::size_t, bool) const noexcept {}
+
+        T* m_tracer;
+    };
+
+    /**
+     * @brief Line reader that reports the phases of the reads of the line reader it wraps to a tracer.
+     *
+     * Nothing is traced until a tracer is set.
+     */
+    template <typename R, Tracer T>
+    struct TraceReader : ProbeReader<R, TraceReader<R, T>>
+    {
+        using ProbeReader<R, TraceReader>::ProbeReader;
+
+        TraceProbe<T> probe() noexcept { return { m_tracer }; }
+
+        void set_tracer(T* tracer) noexcept { m_tracer = tracer; }
+
+        T* get_tracer() const noexcept { return m_tracer; }
+
+        T* m_tracer = nullptr;
+    };
+}
+
+#endif /* end of include guard: LINR_TRACE_HPP */
@@ -2,8 +2,9 @@
 #define LINR_UTIL_HPP
 
 #include "linr/common.hpp"
+#include "linr/detail/split.hpp"
 
-#include <algorithm>
+#include <type_traits>
 #include <utility>
 
 namespace linr::util
@@ -11,6 +12,9 @@ namespace linr::util
     /**
      * @brief Split a string into an array of strings using a delimiter.
      *
+     * Repeated delimiters are counted as one and the split stops at the first null character or newline.
+     * At runtime the string is classified in blocks using SIMD where available.
+     *
      * @param str The string to split.
      * @param delim Delimiter to split the string by.
      * @return The array of strings, or an empty optional if the string could not be split.
@@ -18,44 +22,12 @@ namespace linr::util
     template <std::size_t N>
     constexpr Opt<Arr<Str, N>> split(Str str, char delim) noexcept
     {
-        Arr<Str, N> res = {};
-
-        std::size_t i = 0;
-        std::size_t j = 0;
-
-        auto find_delim_or_null = [&](std::size_t start) {
-            auto iter = std::find_if(str.begin() + start, str.end(), [&](char chr) {
-                return chr == delim or chr == '\0';
-            });
-            return iter == str.end() ? Str::npos : static_cast<std::size_t>(iter - str.begin());
-        };
-
-        while (i < N and j < str.size() and str[j] != '\0' and str[j] != '\n') {
-            while (j != str.size() and str[j] == delim) {
-                ++j;
-            }
-
-            auto pos = find_delim_or_null(j);
-
-            if (pos == Str::npos) {
-                res[i++] = str.substr(j);
-                break;
-            }
-
-            if (str[pos] == '\0' or str[pos] == '\n') {
-                res[i++] = str.substr(j, pos - j);
-                break;
-            }
-
-            res[i++] = str.substr(j, pos - j);
-            j        = pos + 1;
+#if defined(LINR_SIMD_SSE2)
+        if (not std::is_constant_evaluated()) {
+            return detail::split_blocks<N>(str, delim);
         }
-
-        if (i != N) {
-            return std::nullopt;
-        }
-
-        return res;
+#endif
+        return detail::split_scalar<N>(str, delim);
     }
 
     /**
@@ -79,6 +51,19 @@ namespace linr::util
 
         handler(std::make_index_sequence<N>());
     }
+    /**
+     * @brief Reserve capacity for `rows` more rows in every column.
+     *
+     * @param columns The columns.
+     * @param rows Number of rows to make room for.
+     */
+    template <typename... Ts>
+    void reserve_columns(Columns<Ts...>& columns, std::size_t rows)
+    {
+        for_each_tuple(columns, [&]<std::size_t I, typename C>(C& column) {
+            column.reserve(column.size() + rows);
+        });
+    }
 }
 
 #endif /* end of include guard: LINR_UTIL_HPP */
@@ -1,10 +1,19 @@
 // #undef LINR_ENABLE_GETLINE    // uncomment this to use fgets instead of getline
 
 #include <linr/buf_read.hpp>
+#include <linr/multi_read.hpp>
+#include <linr/parallel_read.hpp>
 #include <linr/read.hpp>
+#include <linr/scan.hpp>
 
 #include <boost/ut.hpp>
 
+#include <cmath>
+#include <cstring>
+#include <memory_resource>
+#include <random>
+#include <ranges>
+
 namespace ut = boost::ut;
 
 struct Idk
@@ -42,6 +51,122 @@ struct linr::CustomParser<Idk>
     }
 };
 
+// parser that receives the parse context
+struct Tag
+{
+    std::pmr::string m_name;
+};
+
+template <>
+struct linr::CustomParser<Tag>
+{
+    Result<Tag> parse(Str str, const ParseContext& context) const noexcept
+    {
+        return make_result<Tag>(std::pmr::string{ str, context.memory_resource() });
+    }
+};
+
+// parser that counts how many times it's called
+struct Counted
+{
+    static inline int s_calls = 0;
+    int               m_value = 0;
+};
+
+template <>
+struct linr::CustomParser<Counted>
+{
+    Result<Counted> parse(Str str) const noexcept
+    {
+        ++Counted::s_calls;
+        auto value = linr::parse<int>(str);
+        return value ? make_result<Counted>(Counted{ *value }) : make_error<Counted>(value.error());
+    }
+};
+
+// enums parsed by name
+enum class Color
+{
+    Red,
+    Green,
+    Blue,
+};
+
+template <>
+struct linr::EnumNames<Color>
+{
+    static constexpr auto names = std::to_array<std::pair<Str, Color>>({
+        { "red", Color::Red },
+        { "green", Color::Green },
+        { "blue", Color::Blue },
+    });
+    static constexpr bool case_insensitive = true;
+};
+
+enum class Opcode : std::uint8_t
+{
+};
+
+template <>
+struct linr::EnumNames<Opcode>
+{
+    // "o00", "o01", ..., "o99"
+    static constexpr auto s_storage = Str{
+        "o00o01o02o03o04o05o06o07o08o09o10o11o12o13o14o15o16o17o18o19o20o21o22o23o24o25o26o27o28o29"
+        "o30o31o32o33o34o35o36o37o38o39o40o41o42o43o44o45o46o47o48o49o50o51o52o53o54o55o56o57o58o59"
+        "o60o61o62o63o64o65o66o67o68o69o70o71o72o73o74o75o76o77o78o79o80o81o82o83o84o85o86o87o88o89"
+        "o90o91o92o93o94o95o96o97o98o99"
+    };
+
+    static constexpr auto names = [] {
+        auto names = std::array<std::pair<Str, Opcode>, 100>{};
+        for (auto i = 0u; i < names.size(); ++i) {
+            names[i] = std::pair{ s_storage.substr(i * 3, 3), static_cast<Opcode>(i) };
+        }
+        return names;
+    }();
+};
+
+// aggregates read field by field
+struct Point
+{
+    int   m_x;
+    float m_y;
+};
+
+// a pointer is not parseable
+struct Record
+{
+    std::string m_name;
+    Point*      m_next;
+};
+
+// neither is a nested aggregate
+struct Row
+{
+    std::pmr::string m_name;
+    Point            m_point;
+};
+
+struct Entry
+{
+    std::pmr::string m_name;
+    int              m_id;
+    Color            m_color;
+};
+
+// neither is an array field, nor are the fields of a base class
+struct Pair
+{
+    int m_values[2];
+    int m_extra;
+};
+
+struct Point3 : Point
+{
+    float m_z;
+};
+
 // default reader, no buf
 struct DefReader
 {
@@ -65,6 +190,23 @@ struct DefReader
     }
 };
 
+#if defined(LINR_POSIX)
+// create a pipe filled with content, returns the read end
+int make_pipe(std::string_view content)
+{
+    int fds[2];
+    if (pipe(fds) != 0) {
+        throw std::runtime_error{ "failed to create pipe" };
+    }
+    auto written = write(fds[1], content.data(), content.size());
+    close(fds[1]);
+    if (written != static_cast<ssize_t>(content.size())) {
+        throw std::runtime_error{ "failed to write to pipe" };
+    }
+    return fds[0];
+}
+#endif
+
 template <typename R>
 void test(R&& reader)
 {
@@ -167,6 +309,877 @@ int main()
         static_assert(linr::Parseable<Idk>);    //
     };
 
+    ut::test("tuple and array parsing stop at the first error") = [] {
+        auto values = std::array<linr::Str, 4>{ "1", "x", "3", "4" };
+
+        Counted::s_calls = 0;
+        auto tuple = linr::parse_into_tuple<Counted, Counted, Counted, Counted>(values);
+        ut::expect(not tuple and tuple.error() == linr::Error::InvalidInput and Counted::s_calls == 2);
+
+        Counted::s_calls = 0;
+        auto array = linr::parse_array<Counted, 4>(values);
+        ut::expect(not array and Counted::s_calls == 2);
+
+        values[1] = "2";
+
+        auto mixed        = std::array<linr::Str, 4>{ "1", "2 2.5", "three", "4" };
+        auto [a, b, c, d] = linr::parse_into_tuple<int, Idk, std::string, Counted>(mixed).value();
+        ut::expect(a == 1 and b.m_int == 2 and c == "three" and d.m_value == 4);
+        ut::expect(linr::parse_array<int, 4>(values).value() == std::array{ 1, 2, 3, 4 });
+    };
+
+    ut::test("enum names") = [] {
+        static_assert(linr::Parseable<Color> and linr::Parseable<Opcode>);
+
+        ut::expect(linr::parse<Color>("red").value() == Color::Red);
+        ut::expect(linr::parse<Color>("GREEN").value() == Color::Green);
+        ut::expect(linr::parse<Color>("bLuE").value() == Color::Blue);
+        ut::expect(linr::parse<Color>("blu").error() == linr::Error::InvalidInput);
+        ut::expect(linr::parse<Color>("").error() == linr::Error::InvalidInput);
+
+        for (auto i = 0; i < 100; ++i) {
+            auto pos  = static_cast<std::size_t>(i) * 3;
+            auto name = std::string{ linr::EnumNames<Opcode>::s_storage.substr(pos, 3) };
+            ut::expect(linr::parse<Opcode>(name).value() == static_cast<Opcode>(i));
+
+            name[0] = 'O';
+            ut::expect(not linr::parse<Opcode>(name).has_value()) << "case sensitive by default";
+        }
+        ut::expect(not linr::parse<Opcode>("o100").has_value());
+
+        auto values      = std::array<linr::Str, 2>{ "Red", "o42" };
+        auto [color, op] = linr::parse_into_tuple<Color, Opcode>(values).value();
+        ut::expect(color == Color::Red and op == Opcode{ 42 });
+    };
+
+    ut::test("scan pattern") = [] {
+        using linr::scan_line;
+
+        auto [x, y, id] = scan_line<"x={} y={} id={}", int, float, std::string>("x=12 y=3.5 id=foo").value();
+        ut::expect(x == 12 and y == 3.5f and id == "foo");
+
+        auto [r, g, b] = scan_line<"Color {{ {} {} {} }}", float, float, float>("Color { 1 2 3 }\n").value();
+        ut::expect(r == 1.0f and g == 2.0f and b == 3.0f);
+
+        auto [lead, trail] = scan_line<"{}, {}", Color, int>("Blue, 7").value();
+        ut::expect(lead == Color::Blue and trail == 7);
+
+        // the literal after a placeholder ends it, the last placeholder takes the rest of the line
+        auto [key, value] = scan_line<"{}=={}", std::string, std::string>("a=b==c==d").value();
+        ut::expect(key == "a=b" and value == "c==d");
+
+        ut::expect(scan_line<"x={} y={}", int, int>("y=1 x=2").error() == linr::Error::InvalidInput);
+        ut::expect(scan_line<"x={} y={}", int, int>("x=1 y=").error() == linr::Error::InvalidInput);
+        ut::expect(scan_line<"x={} y={}", int, int>("x=1 z=2").error() == linr::Error::InvalidInput);
+        ut::expect(scan_line<"x={} y={}", int, int>("x=1").error() == linr::Error::InvalidInput);
+        ut::expect(scan_line<"x={} y={}", int, int>("x=a y=2").error() == linr::Error::InvalidInput);
+        ut::expect(scan_line<"({})", int>("(5)").value() == std::tuple{ 5 });
+        ut::expect(not scan_line<"({})", int>("(5").has_value());
+
+        auto* file = std::tmpfile();
+        std::fputs("move 3 to b\nmove x to c\n", file);
+        std::rewind(file);
+
+        auto reader = linr::BufReader{ file, 16 };
+        auto moved  = reader.scan<"move {} to {}", int, linr::Str>().value();
+        ut::expect(std::get<0>(moved) == 3 and std::get<1>(moved) == "b");
+        ut::expect(reader.scan<"move {} to {}", int, linr::Str>().error() == linr::Error::InvalidInput);
+        ut::expect(reader.scan<"move {} to {}", int, linr::Str>().error() == linr::Error::EndOfFile);
+
+        std::fclose(file);
+    };
+
+    ut::test("aggregate read") = [] {
+        static_assert(linr::detail::field_count<Point>() == 2 and linr::detail::field_count<Entry>() == 3);
+        static_assert(linr::detail::field_count<Row>() == 2);
+        static_assert(linr::ParseableAggregate<Point> and linr::ParseableAggregate<Entry>);
+        static_assert(not linr::ParseableAggregate<Record> and not linr::ParseableAggregate<Row>);
+        static_assert(not linr::ParseableAggregate<Counted>, "has a parser of its own");
+        static_assert(not linr::ParseableAggregate<Pair> and not linr::ParseableAggregate<Point3>);
+        static_assert(linr::detail::field_count<Pair>() == 2);
+
+        auto values = std::array<linr::Str, 2>{ "3", "4.5" };
+        auto point  = linr::parse_into_aggregate<Point>(values).value();
+        ut::expect(point.m_x == 3 and point.m_y == 4.5f);
+
+        values[1] = "y";
+        ut::expect(linr::parse_into_aggregate<Point>(values).error() == linr::Error::InvalidInput);
+
+        auto* file = std::tmpfile();
+        std::fputs("1 2.5\nfoo 7 green\nbar x blue\n", file);
+        std::rewind(file);
+
+        auto arena  = std::pmr::monotonic_buffer_resource{};
+        auto reader = linr::BufReader{ file, 16 };
+        reader.set_context({ &arena });
+
+        auto first = reader.read<Point>().value();
+        ut::expect(first.m_x == 1 and first.m_y == 2.5f);
+
+        auto entry = reader.read<Entry>().value();
+        ut::expect(entry.m_name == "foo" and entry.m_id == 7 and entry.m_color == Color::Green);
+        ut::expect(entry.m_name.get_allocator().resource() == &arena);
+
+        ut::expect(reader.read<Entry>().error() == linr::Error::InvalidInput);
+        ut::expect(reader.read<Point>().error() == linr::Error::EndOfFile);
+
+        std::fclose(file);
+    };
+
+    ut::test("csv read") = [] {
+        auto* file = std::tmpfile();
+        std::fputs(
+            "id,name,score\r\n"
+            "1,plain,2.5\r\n"
+            "2,,0\n"
+            "3,\"quoted, with comma\",1\n"
+            "4,\"say \"\"hi\"\"\",-1\n"
+            "5,\"two\nlines\",7\n"
+            "6,\"\",8\n"
+            "7,a\"b,9\n"
+            "8,\"ab\"c,9\n"
+            "9,too,many,fields\n"
+            "10,few\n"
+            "11,\"unterminated,0\n",
+            file
+        );
+        std::rewind(file);
+
+        using Row   = linr::Tup<int, std::string, float>;
+        auto reader = linr::BufReader{ file, 16 };
+
+        ut::expect(reader.read().has_value()) << "skip the header";
+
+        auto read_row = [&] { return reader.read_csv<int, std::string, float>(); };
+        ut::expect(read_row().value() == Row{ 1, "plain", 2.5f });
+        ut::expect(read_row().value() == Row{ 2, "", 0.0f });
+        ut::expect(read_row().value() == Row{ 3, "quoted, with comma", 1.0f });
+
+        auto [id, view, score] = reader.read_csv<int, linr::Str, float>().value();
+        ut::expect(id == 4 and view == "say \"hi\"" and score == -1.0f);
+
+        ut::expect(read_row().value() == Row{ 5, "two\nlines", 7.0f });
+        ut::expect(read_row().value() == Row{ 6, "", 8.0f });
+
+        for (auto i = 7; i <= 11; ++i) {
+            ut::expect(read_row().error() == linr::Error::InvalidInput) << "line" << i;
+        }
+        ut::expect(read_row().error() == linr::Error::EndOfFile);
+
+        std::fclose(file);
+    };
+
+    ut::test("fixed-width read") = [] {
+        constexpr auto layout = linr::fixed_layout({ { 0, 4 }, { 4, 8 }, { 12, 6 } });
+
+        auto record             = linr::Str{ "0042  alice  12.5" };
+        auto [id, name, amount] = linr::parse_fixed<int, std::string, float>(record, layout).value();
+        ut::expect(id == 42 and name == "alice" and amount == 12.5f);
+
+        auto raw = linr::fixed_layout({ { 4, 8 } }, false);
+        ut::expect(std::get<0>(linr::parse_fixed<linr::Str>(record, raw).value()) == "  alice ");
+
+        auto* file = std::tmpfile();
+        std::fputs("   1bob         3\r\n   2carol    \n   xdave       1\n", file);
+        std::rewind(file);
+
+        auto reader = linr::BufReader{ file, 16 };
+
+        auto first = reader.read_fixed<layout, int, linr::Str, int>().value();
+        ut::expect(first == linr::Tup<int, linr::Str, int>{ 1, "bob", 3 });
+
+        // the last column is past the end of the line
+        auto second = reader.read_fixed<int, std::string, int>(layout);
+        ut::expect(second.error() == linr::Error::InvalidInput);
+
+        ut::expect(reader.read_fixed<layout, int, linr::Str, int>().error() == linr::Error::InvalidInput);
+        ut::expect(reader.read_fixed<layout, int, linr::Str, int>().error() == linr::Error::EndOfFile);
+
+        std::fclose(file);
+    };
+
+    ut::test("span reader") = [] {
+        using namespace std::string_view_literals;
+
+        auto data   = std::string{ "1 2.5 abc\n3 4 5\nhello world\n\nlast" };
+        auto reader = linr::SpanReader{ data };
+
+        auto [i, f, s] = reader.read<int, float, linr::Str>().value();
+        ut::expect(i == 1 and f == 2.5f and s == "abc");
+        ut::expect(s.data() == data.data() + 6);    // a view into the buffer, not a copy
+
+        ut::expect(reader.read<int, 3>().value() == linr::Arr<int, 3>{ 3, 4, 5 });
+        ut::expect(reader.read().value() == "hello world");
+        ut::expect(reader.read<int>().error() == linr::Error::InvalidInput);
+        ut::expect(reader.read<linr::Str>().value() == "last");
+        ut::expect(reader.read<int>().error() == linr::Error::EndOfFile);
+        ut::expect(reader.read<int>().error() == linr::Error::EndOfFile);
+
+        // another buffer starts over
+        reader.set_stream("7 8\n"sv);
+        ut::expect(reader.read<int, int>().value() == linr::Tup<int, int>{ 7, 8 });
+        ut::expect(reader.read<int, int>().error() == linr::Error::EndOfFile);
+
+        // so does the same buffer refilled
+        auto buf = std::array<char, 8>{};
+        reader.set_stream(std::span{ buf.data(), "10\n11\n"sv.copy(buf.data(), buf.size()) });
+        ut::expect(reader.read<int>().value() == 10);
+        reader.set_stream(std::span{ buf.data(), "12\n13\n"sv.copy(buf.data(), buf.size()) });
+        ut::expect(reader.read<int>().value() == 12 and reader.read<int>().value() == 13);
+        ut::expect(reader.read<int>().error() == linr::Error::EndOfFile);
+
+        auto empty = linr::SpanReader{ std::span<const char>{} };
+        ut::expect(empty.read().error() == linr::Error::EndOfFile);
+
+        auto csv       = "a,\"b\nc\",1\n"sv;
+        auto rows      = linr::SpanReader{ csv };
+        auto [a, b, n] = rows.read_csv<linr::Str, std::string, int>().value();
+        ut::expect(a == "a" and b == "b\nc" and n == 1);
+    };
+
+    ut::test("reader stats") = [] {
+        auto* file = std::tmpfile();
+        std::fputs("1 2\n3 x\n99999999999 4\n5 6 7 x 9 10 11 12 13 14 15\n5 6\n", file);
+        std::rewind(file);
+
+        auto reader = linr::StatsBufReader<>{ file, 4 };
+
+        ut::expect(reader.read<int, int>().has_value());
+        ut::expect(reader.read<int, int>().error() == linr::Error::InvalidInput);
+        ut::expect(reader.read<int, int>().error() == linr::Error::OutOfRange);
+
+        auto stats = reader.stats();
+        ut::expect(stats.lines == 3 and stats.bytes == 3 + 3 + 13);
+        ut::expect(stats.invalid_input == 1 and stats.out_of_range == 1 and stats.parse_errors() == 2);
+        ut::expect(stats.growths >= 1 and stats.capacity >= 14);
+        ut::expect(stats.read_time.count() == 0 and stats.parse_time.count() == 0);
+
+        reader.reset_stats();
+        ut::expect(reader.stats().lines == 0 and reader.stats().capacity == stats.capacity);
+
+        auto values = std::vector<int>{};
+        ut::expect(reader.read_into(values) == linr::Error::InvalidInput and values.size() == 3);
+        ut::expect(reader.read<int, int>().has_value());
+        ut::expect(reader.read<int, int>().error() == linr::Error::EndOfFile);
+
+        stats = reader.stats();
+        ut::expect(stats.lines == 2 and stats.invalid_input == 1 and stats.out_of_range == 0);
+
+        std::rewind(file);
+        auto timed = linr::StatsBufReader<linr::StatsLevel::Timed>{ file, 64 };
+        while (timed.read<int, int>().has_value() or timed.stats().lines < 5) { }
+
+        stats = timed.stats();
+        ut::expect(stats.lines == 5 and stats.parse_errors() == 2);
+        ut::expect(stats.read_time.count() > 0 and stats.split_time.count() > 0);
+
+#if defined(LINR_POSIX)
+        std::rewind(file);
+        auto fd_reader = linr::StatsFdReader<>{ fileno(file), 8 };
+        while (fd_reader.read<std::string>().has_value()) { }
+
+        // one read per buffer, plus the one that hits the end of the file
+        stats = fd_reader.stats();
+        ut::expect(stats.lines == 5 and stats.refills >= 2);
+#endif
+
+        std::fclose(file);
+    };
+
+    ut::test("read tracing") = [] {
+        struct Recorder
+        {
+            void event(const linr::TraceEvent& event) noexcept { m_events.push_back(event); }
+            void error(linr::Error error, linr::TraceClock::time_point) noexcept
+            {
+                m_errors.push_back(error);
+            }
+
+            std::vector<linr::TraceEvent> m_events;
+            std::vector<linr::Error>      m_errors;
+        };
+
+        auto* file = std::tmpfile();
+        std::fputs("1 2.5\n3\nx 4\n", file);
+        std::rewind(file);
+
+        auto recorder = Recorder{};
+        auto reader   = linr::TracedBufReader<Recorder>{ file, 64 };
+
+        // nothing is traced without a tracer
+        ut::expect(reader.read<int, float>().has_value());
+        reader.set_tracer(&recorder);
+        ut::expect(reader.get_tracer() == &recorder);
+
+        ut::expect(reader.read<int, float>().error() == linr::Error::InvalidInput);
+        ut::expect(reader.read<int, float>().error() == linr::Error::InvalidInput);
+
+        using linr::Phase;
+        auto phases = std::vector<Phase>{};
+        for (const auto& event : recorder.m_events) {
+            phases.push_back(event.phase);
+            ut::expect(event.begin <= event.end);
+        }
+
+        // the split fails on the second line, the parse on the third
+        auto expected = std::vector{ Phase::Read, Phase::Split, Phase::Read, Phase::Split, Phase::Parse };
+        ut::expect(phases == expected);
+        ut::expect(recorder.m_events[0].bytes == 1 and recorder.m_events[2].bytes == 3);
+        ut::expect(recorder.m_errors == std::vector{ linr::Error::InvalidInput, linr::Error::InvalidInput });
+
+        auto* out = std::tmpfile();
+        {
+            auto trace  = linr::ChromeTrace{ out };
+            auto traced = linr::TracedBufReader<linr::ChromeTrace>{ file, 64 };
+            traced.set_tracer(&trace);
+
+            std::rewind(file);
+            for (auto i = 0; i < 4; ++i) {
+                [[maybe_unused]] auto result = traced.read<int, float>();
+            }
+        }
+
+        auto json = std::string(4096, '\0');
+        std::rewind(out);
+        json.resize(std::fread(json.data(), 1, json.size(), out));
+
+        ut::expect(json.starts_with("[\n{\"name\":\"readline\"") and json.ends_with("}\n]\n"));
+        ut::expect(json.find("\"name\":\"parse\",\"cat\":\"linr\",\"ph\":\"X\"") != std::string::npos);
+        ut::expect(json.find("\"name\":\"InvalidInput\",\"cat\":\"linr\",\"ph\":\"i\"") != std::string::npos);
+
+        std::fclose(out);
+        std::fclose(file);
+    };
+
+#if defined(__linux__)
+    ut::test("multi reader") = [] {
+        using Line = linr::SourceResult<int, int>;
+
+        int first[2];
+        int second[2];
+        ut::expect(::pipe(first) == 0 and ::pipe(second) == 0);
+
+        auto write = [](int fd, std::string_view str) {
+            ut::expect(::write(fd, str.data(), str.size()) == static_cast<ssize_t>(str.size()));
+        };
+
+        auto reader = linr::MultiReader{ 4 };
+        auto a      = reader.add(first[0]).value();
+        auto b      = reader.add(second[0]).value();
+        ut::expect(a != b and reader.active() == 2);
+
+        // a regular file can't be watched
+        auto* file = std::tmpfile();
+        ut::expect(reader.add(fileno(file)).error() == linr::Error::Unknown);
+        std::fclose(file);
+
+        // the partial line of the first source waits for the rest
+        write(first[1], "1 2\n3");
+        write(second[1], "10 20\nx 30\n");
+
+        auto lines = std::vector<Line>{};
+        for (auto i = 0; i < 3; ++i) {
+            lines.push_back(reader.read<int, int>());
+        }
+
+        auto from = [&](std::size_t source) {
+            auto values = std::vector<linr::Results<int, int>>{};
+            for (const auto& line : lines) {
+                if (line.source == source) {
+                    values.push_back(line.result);
+                }
+            }
+            return values;
+        };
+
+        auto from_a = from(a);
+        auto from_b = from(b);
+        ut::expect(from_a.size() == 1 and from_a[0].value() == linr::Tup<int, int>{ 1, 2 });
+        ut::expect(from_b.size() == 2 and from_b[0].value() == linr::Tup<int, int>{ 10, 20 });
+        ut::expect(from_b[1].error() == linr::Error::InvalidInput);
+
+        // a line longer than the buffer, and a last line without newline
+        write(first[1], " 4\n55555 66666\n7 8");
+        ::close(first[1]);
+
+        auto line = reader.read<int, int>();
+        ut::expect(line.source == a and line.result.value() == linr::Tup<int, int>{ 3, 4 });
+        line = reader.read<int, int>();
+        ut::expect(line.source == a and line.result.value() == linr::Tup<int, int>{ 55555, 66666 });
+        line = reader.read<int, int>();
+        ut::expect(line.source == a and line.result.value() == linr::Tup<int, int>{ 7, 8 });
+        line = reader.read<int, int>();
+        ut::expect(line.source == a and line.result.error() == linr::Error::EndOfFile);
+        ut::expect(reader.active() == 1);
+
+        ::close(second[1]);
+        line = reader.read<int, int>();
+        ut::expect(line.source == b and line.result.error() == linr::Error::EndOfFile);
+        line = reader.read<int, int>();
+        ut::expect(line.source == linr::MultiReader::no_source);
+        ut::expect(line.result.error() == linr::Error::EndOfFile);
+
+        ::close(first[0]);
+        ::close(second[0]);
+    };
+#endif
+
+    ut::test("split matches the scalar split") = [] {
+        using linr::detail::split_scalar, linr::util::split;
+
+        constexpr auto alphabet = std::string_view{ "ab1 ,,  \n\0", 10 };
+
+        auto rng  = std::mt19937{ 42 };
+        auto line = std::string{};
+
+        auto check = [&]<std::size_t... Ns>(std::index_sequence<Ns...>, char delim) {
+            ((ut::expect(split<Ns + 1>(line, delim) == split_scalar<Ns + 1>(line, delim))), ...);
+        };
+
+        for (auto i = 0; i < 2000; ++i) {
+            line.resize(rng() % 300);
+            for (auto& c : line) {
+                c = alphabet[rng() % alphabet.size()];
+            }
+            for (auto delim : { ' ', ',', '\n' }) {
+                check(std::make_index_sequence<8>{}, delim);
+            }
+        }
+
+        static_assert(split<3>("1  2 3", ' ') == split_scalar<3>("1  2 3", ' '));
+    };
+
+    ut::test("integer parser matches from_chars") = [] {
+        constexpr auto alphabet = std::string_view{ "0123456789000999-+ a" };
+
+        auto rng = std::mt19937{ 42 };
+        auto str = std::string{};
+
+        auto check = [&]<typename T>() {
+            auto expected = T{};
+            auto [_, ec]  = std::from_chars(str.data(), str.data() + str.size(), expected);
+            auto result   = linr::parse<T>(str);
+
+            if (ec == std::errc::invalid_argument) {
+                ut::expect(not result and result.error() == linr::Error::InvalidInput);
+            } else if (ec == std::errc::result_out_of_range) {
+                ut::expect(not result and result.error() == linr::Error::OutOfRange);
+            } else {
+                ut::expect(result and result.value() == expected);
+            }
+        };
+
+        for (auto i = 0; i < 20000; ++i) {
+            str.resize(rng() % 25);
+            for (auto& c : str) {
+                c = alphabet[rng() % alphabet.size()];
+            }
+            if (rng() % 2 == 0) {
+                str.insert(0, "-");
+            }
+
+            check.template operator()<signed char>();
+            check.template operator()<unsigned char>();
+            check.template operator()<short>();
+            check.template operator()<unsigned short>();
+            check.template operator()<int>();
+            check.template operator()<unsigned int>();
+            check.template operator()<long>();
+            check.template operator()<unsigned long>();
+            check.template operator()<long long>();
+            check.template operator()<unsigned long long>();
+        }
+
+        ut::expect(linr::parse<long long>("-9223372036854775808").value() == INT64_MIN);
+        ut::expect(linr::parse<long long>("-9223372036854775809").error() == linr::Error::OutOfRange);
+        ut::expect(linr::parse<unsigned long long>("18446744073709551615").value() == UINT64_MAX);
+        ut::expect(
+            linr::parse<unsigned long long>("18446744073709551616").error() == linr::Error::OutOfRange
+        );
+        ut::expect(linr::parse<unsigned int>("-1").error() == linr::Error::InvalidInput);
+    };
+
+    ut::test("float parser matches from_chars") = [] {
+        constexpr auto alphabet = std::string_view{ "0123456789000999..eE-+" };
+
+        auto rng = std::mt19937{ 42 };
+        auto str = std::string{};
+
+        auto check = [&]<typename T>() {
+            auto expected = T{};
+            auto [_, ec]  = std::from_chars(str.data(), str.data() + str.size(), expected);
+            auto result   = linr::parse<T>(str);
+
+            if (ec == std::errc::invalid_argument) {
+                ut::expect(not result and result.error() == linr::Error::InvalidInput);
+            } else if (ec == std::errc::result_out_of_range) {
+                ut::expect(not result and result.error() == linr::Error::OutOfRange);
+            } else {
+                ut::expect(result and std::memcmp(&result.value(), &expected, sizeof(T)) == 0) << str;
+            }
+        };
+
+        for (auto i = 0; i < 20000; ++i) {
+            str.resize(rng() % 30);
+            for (auto& c : str) {
+                c = alphabet[rng() % alphabet.size()];
+            }
+
+            check.template operator()<float>();
+            check.template operator()<double>();
+        }
+
+        ut::expect(linr::parse<double>("2.2250738585072014e-308").value() == 2.2250738585072014e-308);
+        ut::expect(linr::parse<double>("9007199254740993").value() == 9007199254740992.0);
+        ut::expect(linr::parse<float>("1e39").error() == linr::Error::OutOfRange);
+        ut::expect(std::signbit(linr::parse<double>("-0.0").value()));
+    };
+
+    ut::test("batch read stops at the line limit or the first error") = [] {
+        auto* file = std::tmpfile();
+        std::fputs("1 2\n3 4\n5 6\n7 x\n8 9\n", file);
+        std::rewind(file);
+
+        auto reader = linr::BufReader{ file, 16 };
+        auto rows   = std::vector<linr::Tup<int, int>>{};
+
+        // `read_batch` and `read_columns` reject `linr::Str` with a static_assert, the views of a batch
+        // would dangle as soon as the line buffer is reused for the next line
+
+        auto [count, error] = reader.read_batch(2, rows);
+        ut::expect(count == 2 and not error.has_value());
+        ut::expect(rows.size() == 2 and rows[1] == linr::Tup<int, int>{ 3, 4 });
+
+        auto second = reader.read_batch(10, rows);
+        ut::expect(second.count == 1 and second.error == linr::Error::InvalidInput);
+        ut::expect(rows.size() == 3 and rows[2] == linr::Tup<int, int>{ 5, 6 });
+
+        auto arrays = std::vector<linr::Arr<int, 2>>{};
+        auto third  = reader.read_batch(10, arrays);
+        ut::expect(third.count == 1 and third.error == linr::Error::EndOfFile);
+        ut::expect(arrays.size() == 1 and arrays[0] == linr::Arr<int, 2>{ 8, 9 });
+
+        std::fclose(file);
+    };
+
+    ut::test("column read keeps the columns the same length") = [] {
+        auto* file = std::tmpfile();
+        std::fputs("1 a 0.5\n2 b 1.5\n3 c x\n4 d 2.5\n", file);
+        std::rewind(file);
+
+        auto reader  = linr::BufReader{ file, 16 };
+        auto columns = linr::Columns<int, char, float>{};
+        linr::util::reserve_columns(columns, 8);
+
+        auto [count, error] = reader.read_columns(10, columns);
+        ut::expect(count == 2 and error == linr::Error::InvalidInput);
+
+        auto& [ints, chars, floats] = columns;
+        ut::expect(ints == std::vector{ 1, 2 } and chars == std::vector{ 'a', 'b' });
+        ut::expect(floats == std::vector{ 0.5f, 1.5f });
+        ut::expect(ints.capacity() >= 8);
+
+        auto rest = reader.read_columns<int, char, float>(10, ' ', linr::Reserve{ 4 }).value();
+        ut::expect(std::get<0>(rest) == std::vector{ 4 } and std::get<2>(rest) == std::vector{ 2.5f });
+        ut::expect(reader.read_columns<int, char, float>(10).error() == linr::Error::EndOfFile);
+
+        // a parse error after some rows fails the read of new columns
+        auto* bad = std::tmpfile();
+        std::fputs("1,a,0.5\n2,b,1.5\n3,c,x\n", bad);
+        std::rewind(bad);
+
+        // the reserve hint can't be mistaken for the delimiter
+        static_assert(not std::convertible_to<char, linr::Reserve>);
+
+        reader.set_stream(bad);
+        auto first = reader.read_columns<int, char, float>(1, ',', linr::Reserve{ 4 }).value();
+        ut::expect(std::get<0>(first) == std::vector{ 1 } and std::get<0>(first).capacity() >= 4);
+
+        auto failed = reader.read_columns<int, char, float>(10, ',');
+        ut::expect(failed.error() == linr::Error::InvalidInput);
+
+        std::fclose(bad);
+        std::fclose(file);
+    };
+
+    ut::test("lines range yields every line until EOF") = [] {
+        auto* file = std::tmpfile();
+        std::fputs("1 0.5\n2 x\n3 1.5\n4 2.5\n", file);
+        std::rewind(file);
+
+        auto reader = linr::BufReader{ file, 16 };
+        static_assert(std::ranges::input_range<decltype(reader.lines<int, float>())>);
+
+        auto ints = std::vector<int>{};
+        for (auto&& row : reader.lines<int, float>() | std::views::take(3)) {
+            ints.push_back(row ? std::get<0>(*row) : -1);
+        }
+        ut::expect(ints == std::vector{ 1, -1, 3 });
+
+        auto rest = 0;
+        for (auto&& row : reader.lines<int, float>()) {
+            ut::expect(row and std::get<0>(*row) == 4);
+            ++rest;
+        }
+        ut::expect(rest == 1);
+
+        std::fclose(file);
+    };
+
+    ut::test("read-ahead reader handles lines spanning buffers") = [] {
+        auto* file = std::tmpfile();
+        auto  long_line = std::string(100, 'x');
+        std::fputs(("1 2 3\n" + long_line + "\n4.5 hello\n\n").c_str(), file);
+        for (auto i = 0; i < 1000; ++i) {
+            std::fprintf(file, "%d %d\n", i, i * 2);
+        }
+        std::fputs("last", file);
+        std::rewind(file);
+
+        auto reader = linr::ReadAheadReader{ file, 4, linr::ReadAhead{ .buffers = 2 } };
+
+        auto [a, b, c] = reader.read<int, int, int>().value();
+        ut::expect(a == 1 and b == 2 and c == 3);
+        ut::expect(reader.read().value() == long_line);
+
+        auto [f, s] = reader.read<float, std::string>().value();
+        ut::expect(f == 4.5f and s == "hello");
+        ut::expect(reader.read().error() == linr::Error::InvalidInput);    // empty line
+
+        auto rows = std::vector<linr::Arr<int, 2>>{};
+        ut::expect(reader.read_batch(1000, rows).count == 1000);
+        ut::expect(rows.back() == linr::Arr<int, 2>{ 999, 1998 });
+
+        ut::expect(reader.read().value() == "last");
+        ut::expect(reader.read().error() == linr::Error::EndOfFile);
+
+        std::fclose(file);
+    };
+
+#if defined(LINR_POSIX)
+    ut::test("read-ahead reader hands lines over as they arrive and restarts on set_stream") = [] {
+        int fds[2];
+        ut::expect(pipe(fds) == 0);
+
+        auto* pipe_in = fdopen(fds[0], "r");
+        auto  reader  = linr::ReadAheadReader{ pipe_in, 64, linr::ReadAhead{ .buffers = 2 } };
+
+        // the write end stays open, the line must not wait for the buffer to fill up
+        ut::expect(write(fds[1], "1 2\n", 4) == 4);
+        ut::expect(reader.read<int, int>().value() == linr::Tup<int, int>{ 1, 2 });
+
+        ut::expect(write(fds[1], "3\n", 2) == 2);
+        close(fds[1]);
+        ut::expect(reader.read<int>().value() == 3);
+        ut::expect(reader.read<int>().error() == linr::Error::EndOfFile);
+
+        // the new stream is read from its current position
+        auto* file = std::tmpfile();
+        std::fputs("header\n4\n", file);
+        std::rewind(file);
+
+        char header[16];
+        std::fgets(header, sizeof(header), file);
+
+        reader.set_stream(file);
+        ut::expect(reader.read<int>().value() == 4);
+        ut::expect(reader.read<int>().error() == linr::Error::EndOfFile);
+
+        std::fclose(file);
+        std::fclose(pipe_in);
+    };
+#endif
+
+    ut::test("vector read takes every value of the line") = [] {
+        auto* file = std::tmpfile();
+        std::fputs("1 2 3 4 5\n  6   7 \n\n8 x 9\n0.5 1.5\n", file);
+        std::rewind(file);
+
+        auto reader = linr::BufReader{ file, 16 };
+        auto values = std::vector<int>{};
+
+        ut::expect(not reader.read_into(values).has_value() and values == std::vector{ 1, 2, 3, 4, 5 });
+
+        const auto* storage = values.data();
+        ut::expect(not reader.read_into(values).has_value() and values == std::vector{ 6, 7 });
+        ut::expect(values.data() == storage);
+
+        ut::expect(not reader.read_into(values).has_value() and values.empty());
+        ut::expect(reader.read_into(values) == linr::Error::InvalidInput and values == std::vector{ 8 });
+
+        ut::expect(reader.read<std::vector<double>>().value() == std::vector{ 0.5, 1.5 });
+        ut::expect(reader.read<std::vector<double>>().error() == linr::Error::EndOfFile);
+
+        std::fclose(file);
+    };
+
+    ut::test("string views refer to the line buffer of the reader") = [] {
+        auto* file = std::tmpfile();
+        std::fputs("alpha 1 beta\ngamma\n", file);
+        std::rewind(file);
+
+        auto reader = linr::BufReader{ file, 64 };
+
+        auto [first, number, second] = reader.read<linr::Str, int, linr::Str>().value();
+        ut::expect(first == "alpha" and number == 1 and second == "beta");
+        ut::expect(first.data() + 8 == second.data());    // same buffer, no copy
+
+        ut::expect(reader.read<linr::Str>().value() == "gamma");
+        ut::expect(reader.read<linr::Str>().error() == linr::Error::EndOfFile);
+
+        std::fclose(file);
+    };
+
+    ut::test("pmr strings are allocated from the context resource") = [] {
+        auto* file = std::tmpfile();
+        std::fputs("a-name-that-doesnt-fit-in-sso 1 a-tag-that-doesnt-fit-in-sso\n", file);
+        std::fputs("another-name-that-doesnt-fit-in-sso 2 another-tag-that-doesnt-fit-in-sso\n", file);
+        std::rewind(file);
+
+        auto buffer   = std::array<std::byte, 4096>{};
+        auto upstream = std::pmr::null_memory_resource();
+        auto arena    = std::pmr::monotonic_buffer_resource{ buffer.data(), buffer.size(), upstream };
+        auto in_arena = [&](const char* ptr) {
+            auto* byte = reinterpret_cast<const std::byte*>(ptr);
+            return byte >= buffer.data() and byte < buffer.data() + buffer.size();
+        };
+
+        auto reader = linr::BufReader{ file, 16 };
+        reader.set_context({ .resource = &arena });
+
+        auto rows = std::vector<linr::Tup<std::pmr::string, int, Tag>>{};
+        ut::expect(reader.read_batch(2, rows).count == 2);
+
+        auto& [name, number, tag] = rows[1];
+        ut::expect(name == "another-name-that-doesnt-fit-in-sso" and number == 2);
+        ut::expect(tag.m_name == "another-tag-that-doesnt-fit-in-sso");
+        ut::expect(in_arena(name.data()) and in_arena(tag.m_name.data()));
+
+        rows.clear();
+        arena.release();
+
+        auto fallback = linr::parse<std::pmr::string>("default").value();
+        ut::expect(fallback.get_allocator().resource() == std::pmr::get_default_resource());
+
+        std::fclose(file);
+    };
+
+#if defined(LINR_POSIX)
+    ut::test("fd reader handles lines spanning a refill") = [] {
+        auto long_line = std::string(100, 'x');
+        auto fd        = make_pipe("1 2 3\n" + long_line + "\n4.5 hello\n\nlast");
+        auto reader    = linr::FdReader{ fd, 4 };
+
+        auto [a, b, c] = reader.read<int, int, int>().value();
+        ut::expect(a == 1 and b == 2 and c == 3);
+        ut::expect(reader.read().value() == long_line);
+
+        auto [f, s] = reader.read<float, std::string>().value();
+        ut::expect(f == 4.5f and s == "hello");
+
+        ut::expect(reader.read().error() == linr::Error::InvalidInput);    // empty line
+        ut::expect(reader.read().value() == "last");
+        ut::expect(reader.read().error() == linr::Error::EndOfFile);
+
+        close(fd);
+    };
+
+    ut::test("fd reader starts over on another descriptor") = [] {
+        auto first  = make_pipe("1\n2");
+        auto second = make_pipe("3\n");
+        auto reader = linr::StatsFdReader<>{ first, 4 };
+
+        ut::expect(reader.read<int>().value() == 1 and reader.read<int>().value() == 2);
+        ut::expect(reader.read<int>().error() == linr::Error::EndOfFile);
+
+        reader.set_stream(second);
+        ut::expect(reader.read<int>().value() == 3);
+        ut::expect(reader.read<int>().error() == linr::Error::EndOfFile);
+
+        close(first);
+        close(second);
+    };
+
+    ut::test("mapped reader reads a regular file from its current position") = [] {
+        auto* file = std::tmpfile();
+        std::fputs("skipped line\n1 2 3\n4.5 hello\nlast", file);
+        std::rewind(file);
+
+        char buf[32];
+        std::fgets(buf, sizeof(buf), file);
+
+        auto reader = linr::MappedReader{ file };
+
+        auto [a, b, c] = reader.read<int, 3>().value();
+        ut::expect(a == 1 and b == 2 and c == 3);
+
+        auto [f, s] = reader.read<float, std::string>().value();
+        ut::expect(f == 4.5f and s == "hello");
+
+        ut::expect(reader.read().value() == "last");
+        ut::expect(reader.read().error() == linr::Error::EndOfFile);
+
+        std::fclose(file);
+    };
+
+    ut::test("mapped reader maps the new stream on set_stream") = [] {
+        auto* first = std::tmpfile();
+        std::fputs("a\nb", first);
+        std::rewind(first);
+
+        auto reader = linr::MappedReader{ first };
+        ut::expect(reader.read().value() == "a");
+        std::fclose(first);
+
+        // the new stream may get the address of the closed one
+        auto* second = std::tmpfile();
+        std::fputs("x", second);
+        std::rewind(second);
+
+        reader.set_stream(second);
+        ut::expect(reader.read().value() == "x");
+        ut::expect(reader.read().error() == linr::Error::EndOfFile);
+
+        std::fclose(second);
+    };
+
+    ut::test("parallel read keeps the input order and the global line of the error") = [] {
+        auto* file = std::tmpfile();
+        for (auto i = 0; i < 100'000; ++i) {
+            if (i == 54'321) {
+                std::fputs("oops 1\n", file);
+            } else {
+                std::fprintf(file, "%d %d\n", i, -i);
+            }
+        }
+        std::rewind(file);
+
+        auto [rows, error] = linr::parallel_read<int, int>(fileno(file), 4);
+        ut::expect(error == linr::Error::InvalidInput and rows.size() == 54'321);
+
+        auto ordered = true;
+        for (auto i = 0; i < static_cast<int>(rows.size()); ++i) {
+            ordered = ordered and rows[static_cast<std::size_t>(i)] == linr::Tup<int, int>{ i, -i };
+        }
+        ut::expect(ordered);
+
+        std::fclose(file);
+
+        auto missing = linr::parallel_read<int>("/nonexistent/linr/file");
+        ut::expect(missing.rows.empty() and missing.error == linr::Error::Unknown);
+    };
+
+    ut::test("mapped reader rejects non-regular file") = [] {
+        auto  fd   = make_pipe("1 2 3\n");
+        auto* file = fdopen(fd, "r");
+
+        auto reader = linr::MappedReader{ file };
+        ut::expect(reader.read<int>().error() == linr::Error::Unknown);
+
+        std::fclose(file);
+    };
+#endif
+
     test(DefReader{});
     test(linr::BufReader{ 1024 });
 }